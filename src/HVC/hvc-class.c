@@ -48,6 +48,18 @@
 
 
 
+typedef struct hvccheckpoint {
+    int trailsize;
+    int n;
+    int ndom;
+    int leastContributorix;
+    int updated;
+    int hvupdated;
+    int saved;
+    int epoch;
+    double hv;
+} hvc_checkpoint_t;
+
 struct hvcstruct {
     dlnode_t * list;
     double * contribs;
@@ -60,6 +72,7 @@ struct hvcstruct {
     int d;
     
     dlnode_t ** i2struct; //to be removed
+    dlnode_t ** id2struct; //node of each id in use
     
     int * freeSpaces;
     int * freeIds;
@@ -70,10 +83,22 @@ struct hvcstruct {
     int hvupdated;
 
     int saved; //are the contributions saved in contribs vector?
+    int pointssaved; //are the points saved in points vector? (only meaningful if saved == 1)
 
     int ndom; // not fully implemented yet
 
     int * selected;
+
+    dlnode_t ** unselected; //nodes of the points that are not enabled, in no particular order
+    int * unselectedix; //position in unselected of the node in each slot
+    int nunselected;
+
+    int epoch; //incremented whenever the contributions or their saved copy change
+
+    dltrail_t trail;
+    hvc_checkpoint_t * checkpoints;
+    int ncheckpoints;
+    int ncheckpointsaloc;
 }; 
 
 int *getSelected(hvc_s *hvcs){
@@ -92,7 +117,8 @@ static void allocateMoreSpace(){
 static dlnode_t * newPoint(hvc_s * hvcs, double * point){
     
     dlnode_t * p = hvcs->list + hvcs->freeSpaces[hvcs->n];
-    p->id = hvcs->freeIds[hvcs->n];
+    coldNode(hvcs->list, p)->id = hvcs->freeIds[hvcs->n];
+    setLink(hvcs->list, &hvcs->id2struct[hvcs->freeIds[hvcs->n]], p);
         
     p = point2Struct(hvcs->list, p, point, hvcs->d);
 
@@ -101,15 +127,34 @@ static dlnode_t * newPoint(hvc_s * hvcs, double * point){
     return p;
 }
 
+//the changes to the unselected points are recorded in the trail, so a rollback restores them
+static void addUnselected(hvc_s * hvcs, dlnode_t * p){
+    dlnode_t * list = hvcs->list;
+    int ix = hvcs->nunselected;
+
+    setLink(list, &hvcs->unselected[ix], p);
+    setInt(list, &hvcs->unselectedix[p - list], ix);
+    setInt(list, &hvcs->nunselected, ix + 1);
+}
+
+static void removeUnselected(hvc_s * hvcs, dlnode_t * p){
+    dlnode_t * list = hvcs->list;
+    int ix = hvcs->unselectedix[p - list];
+    dlnode_t * last = hvcs->unselected[hvcs->nunselected - 1];
+
+    setLink(list, &hvcs->unselected[ix], last);
+    setInt(list, &hvcs->unselectedix[last - list], ix);
+    setInt(list, &hvcs->nunselected, hvcs->nunselected - 1);
+}
+
 //assumes hvcs->updated == 1
 static void saveContributions(hvc_s * hvcs){
     if(!hvcs->updated) updateAllContributions(hvcs);
     
-    int i, j, d = hvcs->d;
+    int i;
     dlnode_t * list = hvcs->list;
     dlnode_t * p;
     
-    double * points = hvcs->points;
     double * contribs = hvcs->contribs;
     dlnode_t ** i2struct = hvcs->i2struct;
     
@@ -121,10 +166,9 @@ static void saveContributions(hvc_s * hvcs){
         if(hvcs->d == 3){
             contribs[i] = p->volume;
         }else{ // if(hvcs->d == 4){
-            contribs[i] = p->hvolume;
+            contribs[i] = coldNode(list, p)->hvolume;
         }
         i2struct[i] = p;
-        for(j = 0; j < d; j++) points[d * i +j] = p->x[j];
         if(contribs[i] < minContr){
             minContr = contribs[i];
             leastContrix = i;
@@ -134,9 +178,24 @@ static void saveContributions(hvc_s * hvcs){
     }
     hvcs->leastContributorix = leastContrix;
     hvcs->saved = 1;
+    hvcs->pointssaved = 0;
+    hvcs->epoch++;
 
 }
 
+//copies the points in the same order as the saved contributions
+static void savePoints(hvc_s * hvcs){
+    if(!hvcs->saved) saveContributions(hvcs);
+    
+    int i, j, d = hvcs->d;
+    double * points = hvcs->points;
+    
+    for(i = 0; i < hvcs->n; i++)
+        for(j = 0; j < d; j++) points[d * i + j] = hvcs->i2struct[i]->x[j];
+    
+    hvcs->pointssaved = 1;
+}
+
 
 
 
@@ -145,9 +204,13 @@ static int removePointNode(hvc_s * hvcs, dlnode_t * point, int updateContr){
     
     dlnode_t * list = hvcs->list;
     
+    //the slot of the point may be reused before a rollback
+    saveNode(list, point);
+    
     if(point->ndomr < 2){
         removeFromDataStructure(list, point);
         if(updateContr){
+            hvcs->epoch++;
             if(!hvcs->updated){
                 int considerDominated = 1;
                 hvcs->hv = hvc3d(hvcs->list, considerDominated);
@@ -166,17 +229,20 @@ static int removePointNode(hvc_s * hvcs, dlnode_t * point, int updateContr){
         if(updateContr && !hvcs->updated){
             int considerDominated = 1;
             hvcs->hv = hvc3d(hvcs->list, considerDominated);
+            hvcs->epoch++;
         }
         hvcs->ndom -= 1;
     }
-    removeFromHistory(point);
+    removeFromHistory(list, point);
+    if(!point->enabled) removeUnselected(hvcs, point);
     
-    int id = point->id;
+    int id = coldNode(list, point)->id;
     hvcs->n -= 1;
     if(hvcs->n == 0) hvcs->hv = 0; //force zero, otherwise, it could be different from zero due to rounding problems 
+    //entries below n are never read, so a rollback only needs to restore n
     hvcs->freeSpaces[hvcs->n] = (point-list);
     hvcs->freeIds[hvcs->n] = id;
-    point->id = -1; 
+    coldNode(list, point)->id = -1; 
     hvcs->saved = 0;
     hvcs->leastContributorix = -1;
     return 1;
@@ -201,7 +267,7 @@ static dlnode_t * getLeastContributorNode(hvc_s * hvcs){
         if(hvcs->d == 3){
             contr = p->volume;
         }else{
-            contr = p->hvolume;
+            contr = coldNode(list, p)->hvolume;
         }
         if(contr < minContr){
             minContr = contr;
@@ -252,6 +318,14 @@ hvc_s * init(double * data, int d, int n, int naloc, double *ref){
     
     hvc_s * hvcs = (hvc_s *) malloc(sizeof(hvc_s));
     hvcs->list = setup_cdllist(newdata, naloc, n, d, newRef);
+    if(hvcs->list == NULL){
+        warnprintf("ERROR!! could not allocate the nodes of %d points\n", naloc);
+        free(newdata);
+        free(contribs);
+        free(newRef);
+        free(hvcs);
+        return NULL;
+    }
 
     hvcs->points = newdata; 
     hvcs->ref = newRef;
@@ -266,9 +340,20 @@ hvc_s * init(double * data, int d, int n, int naloc, double *ref){
     hvcs->updated = (n > 0) ? 0 : 1;
     hvcs->hvupdated = 0; 
     hvcs->saved = (n > 0) ? 0 : 1;
+    hvcs->pointssaved = 1; //the input order is the order of insertion
     hvcs->leastContributorix = -1;
     
     hvcs->i2struct = (dlnode_t **) malloc((naloc) * sizeof(dlnode_t *)); 
+    hvcs->id2struct = (dlnode_t **) malloc((naloc) * sizeof(dlnode_t *)); 
+    for(dlnode_t * p = hvcs->list->next[0]; p != hvcs->list; p = p->next[0])
+        hvcs->id2struct[coldNode(hvcs->list, p)->id] = p;
+    
+    //no point is enabled yet
+    hvcs->unselected = (dlnode_t **) malloc((naloc) * sizeof(dlnode_t *));
+    hvcs->unselectedix = (int *) malloc((naloc + 3) * sizeof(int));
+    hvcs->nunselected = 0;
+    for(dlnode_t * p = hvcs->list->next[0]; p != hvcs->list; p = p->next[0])
+        addUnselected(hvcs, p);
     
     int * freeSpaces = (int *) malloc((naloc) * sizeof(int));
     int * freeIds = (int *) malloc((naloc) * sizeof(int));
@@ -289,6 +374,15 @@ hvc_s * init(double * data, int d, int n, int naloc, double *ref){
     for(i = 0; i < naloc; i++) selected[i] = 0;
     hvcs->selected = selected;
     
+    hvcs->epoch = 0;
+    hvcs->trail.entries = NULL;
+    hvcs->trail.size = hvcs->trail.naloc = 0;
+    hvcs->trail.images = NULL;
+    hvcs->trail.coldimages = NULL;
+    hvcs->trail.nimages = hvcs->trail.nimagesaloc = 0;
+    hvcs->checkpoints = NULL;
+    hvcs->ncheckpoints = hvcs->ncheckpointsaloc = 0;
+    
     return hvcs;
 }
 
@@ -299,12 +393,20 @@ double dealloc(hvc_s * hvcs){
     free(hvcs->contribs);    
     
     free(hvcs->i2struct);
+    free(hvcs->id2struct);
     free(hvcs->freeSpaces);
     free(hvcs->freeIds);
     free(hvcs->points);
     free(hvcs->ref);
 
     free(hvcs->selected);
+    free(hvcs->unselected);
+    free(hvcs->unselectedix);
+    
+    free(hvcs->trail.entries);
+    free(hvcs->trail.images);
+    free(hvcs->trail.coldimages);
+    free(hvcs->checkpoints);
     
     free(hvcs);
     return 0;
@@ -338,6 +440,7 @@ void updateAllContributions(hvc_s * hvcs){
         
         hvcs->updated = 1;
         hvcs->saved = 0;
+        hvcs->epoch++;
     }
 }
 
@@ -353,10 +456,30 @@ int getAlocsize(hvc_s * hvcs){
 }
 
 double * getPoints(hvc_s * hvcs){
-    if(!hvcs->saved) saveContributions(hvcs);
+    if(!hvcs->saved || !hvcs->pointssaved) savePoints(hvcs);
     return hvcs->points;
 }
 
+double contributionAt(hvc_s * hvcs, int id){
+    if(!hvcs->updated) updateAllContributions(hvcs);
+    
+    dlnode_t * p = hvcs->id2struct[id];
+    return (hvcs->d == 3) ? p->volume : coldNode(hvcs->list, p)->hvolume;
+}
+
+//walks only the points that are not enabled, in no particular order, and does not save anything
+int getUnselectedContributions(hvc_s * hvcs, double * contribs){
+    if(!hvcs->updated) updateAllContributions(hvcs);
+    
+    int i;
+    dlnode_t * list = hvcs->list;
+    
+    for(i = 0; i < hvcs->nunselected; i++)
+        contribs[i] = (hvcs->d == 3) ? hvcs->unselected[i]->volume : coldNode(list, hvcs->unselected[i])->hvolume;
+    
+    return i;
+}
+
 
 double addPoint(hvc_s * hvcs, double * point, int updateContribs){
     if(hvcs->n == hvcs->naloc){
@@ -373,6 +496,7 @@ double addPoint(hvc_s * hvcs, double * point, int updateContribs){
         hvcs->hv += updateContributions(hvcs->list, newp, 1);
         addToDataStructure(hvcs->list, newp, 0);
         hvcs->updated = 1;
+        hvcs->epoch++;
         
     }else{ //contributions are not updated and do not update them
         addToDataStructure(hvcs->list, newp, 1);
@@ -383,6 +507,7 @@ double addPoint(hvc_s * hvcs, double * point, int updateContribs){
     
     hvcs->saved = 0;
     addToHistory(hvcs->list, newp);
+    addUnselected(hvcs, newp);
     hvcs->n++;
     
     hvcs->leastContributorix = -1;
@@ -437,7 +562,8 @@ int disablePoint(hvc_s * hvcs, double * point){
 
     for(dlnode_t * p = list->next[0]; p != list; p = p->next[0]){
         if(isequal(point, p->x, d)){
-            p->enabled = 0;
+            if(p->enabled) addUnselected(hvcs, p);
+            setInt(list, &p->enabled, 0);
             return 1;
         }
     }
@@ -451,7 +577,8 @@ int enablePoint(hvc_s * hvcs, double * point){
 
     for(dlnode_t * p = list->next[0]; p != list; p = p->next[0]){
         if(isequal(point, p->x, d)){
-            p->enabled = 1;
+            if(!p->enabled) removeUnselected(hvcs, p);
+            setInt(list, &p->enabled, 1);
             return 1;
         }
     }
@@ -471,6 +598,17 @@ int findPointPos(hvc_s * hvcs, double * point){
     return -1;
 }
 
+int findPointId(hvc_s * hvcs, double * point){
+    const int d = hvcs->d;
+    dlnode_t * list = hvcs->list;
+
+    for(dlnode_t * p = list->next[0]; p != list; p = p->next[0])
+        if(isequal(point, p->x, d))
+            return coldNode(list, p)->id;
+
+    return -1;
+}
+
 void removeLeastContributor(hvc_s * hvcs, int updateContribs){
     dlnode_t * leastContributor = getLeastContributorNode(hvcs);
     removePointNode(hvcs, leastContributor, updateContribs);
@@ -486,7 +624,7 @@ int getLeastContributorIndex(hvc_s * hvcs){
 //private - just for gHSSD, to get the original index
 int getLeastContributorId(hvc_s * hvcs){
     if(!hvcs->saved) saveContributions(hvcs);
-    return hvcs->i2struct[hvcs->leastContributorix]->id;
+    return coldNode(hvcs->list, hvcs->i2struct[hvcs->leastContributorix])->id;
 }
 
 
@@ -522,7 +660,7 @@ void printIds(hvc_s * hvcs){
     dlnode_t * p = hvcs->list->next[0];
     
     while(p != hvcs->list){
-        printf("%d\n", p->id);
+        printf("%d\n", coldNode(hvcs->list, p)->id);
         p = p->next[0];
     }
     
@@ -552,6 +690,7 @@ double addOneContribution(hvc_s * hvcs, double * point){
     
     hvcs->saved = 0;
     addToHistory(hvcs->list, newp);
+    addUnselected(hvcs, newp);
     hvcs->n++;
     hvcs->leastContributorix = -1;
     
@@ -569,6 +708,7 @@ double updateHypervolume(hvc_s * hvcs){
     double hv = hv3dplus(hvcs->list);
     hvcs->hv = hv;
     hvcs->hvupdated = 1;
+    hvcs->epoch++;
     return hv;
     
 }
@@ -584,6 +724,63 @@ void changeReferencePoint(hvc_s * hvcs, double * ref){
     hvcs->updated = 0;
     hvcs->hvupdated = 0;
     hvcs->saved = 0;
+    hvcs->epoch++;
+    
     
+}
+
+
+
+/************** checkpoints ***************************************/
+
+
+int checkpoint(hvc_s * hvcs){
+    if(hvcs->ncheckpoints == hvcs->ncheckpointsaloc){
+        hvcs->ncheckpointsaloc = (hvcs->ncheckpointsaloc > 0) ? 2 * hvcs->ncheckpointsaloc : 16;
+        hvcs->checkpoints = (hvc_checkpoint_t *) realloc(hvcs->checkpoints, hvcs->ncheckpointsaloc * sizeof(hvc_checkpoint_t));
+    }
+    
+    hvc_checkpoint_t * cp = hvcs->checkpoints + hvcs->ncheckpoints;
+    cp->trailsize = hvcs->trail.size;
+    cp->n = hvcs->n;
+    cp->ndom = hvcs->ndom;
+    cp->leastContributorix = hvcs->leastContributorix;
+    cp->updated = hvcs->updated;
+    cp->hvupdated = hvcs->hvupdated;
+    cp->saved = hvcs->saved;
+    cp->epoch = hvcs->epoch;
+    cp->hv = hvcs->hv;
+    
+    arenaOf(hvcs->list)->trail = &hvcs->trail;
+    
+    return hvcs->ncheckpoints++;
+}
+
+
+void rollback(hvc_s * hvcs, int i){
+    hvc_checkpoint_t * cp = hvcs->checkpoints + i;
+    
+    trailUndo(hvcs->list, &hvcs->trail, cp->trailsize);
+    
+    hvcs->n = cp->n;
+    hvcs->ndom = cp->ndom;
+    hvcs->hv = cp->hv;
+    
+    //the contributions kept in the nodes are only valid if they were not recomputed meanwhile
+    if(cp->epoch == hvcs->epoch){
+        hvcs->leastContributorix = cp->leastContributorix;
+        hvcs->updated = cp->updated;
+        hvcs->hvupdated = cp->hvupdated;
+        hvcs->saved = cp->saved;
+    }else{
+        hvcs->leastContributorix = -1;
+        hvcs->updated = (hvcs->n > 0) ? 0 : 1;
+        hvcs->hvupdated = 0;
+        hvcs->saved = (hvcs->n > 0) ? 0 : 1;
+        hvcs->epoch++;
+    }
     
+    hvcs->ncheckpoints = i;
+    if(hvcs->ncheckpoints == 0)
+        arenaOf(hvcs->list)->trail = NULL;
 }
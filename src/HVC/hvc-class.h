@@ -41,6 +41,10 @@ double * getContributions(hvc_s * hvcs);
 double totalHV(hvc_s * hvcs);
 double * getPoints(hvc_s * hvc_s); //the order is the same as contributions - contributions are updated after this call (even if they were not before the call)
 int getSize(hvc_s * hvcs);
+
+//per-point queries - these update the contributions if needed, but do not save them
+double contributionAt(hvc_s * hvcs, int id); //contribution of the point with the given id - O(1)
+int getUnselectedContributions(hvc_s * hvcs, double * contribs); //contributions of the points that are not enabled, returns how many - O(number of them)
 int getAllocSize(hvc_s * hvcs);
 
 int isUpToDate(hvc_s * hvcs);
@@ -62,9 +66,22 @@ double dealloc(hvc_s * hvcs);
 int disablePoint(hvc_s * hvcs, double * point);
 int enablePoint(hvc_s * hvcs, double * point);
 int findPointPos(hvc_s * hvcs, double * point);
+int findPointId(hvc_s * hvcs, double * point);
 int *getSelected(hvc_s * hvcs);
 
 
+/* -------- checkpoints -------- */
+/**
+ * checkpoint records the current state and returns a handle to it. Until the
+ * matching rollback, the structural changes are recorded in a trail, so that
+ * rollback restores the recorded state in time proportional to the number of
+ * changes made since the checkpoint. Checkpoints nest: rolling back to one
+ * also discards the checkpoints taken after it, as well as itself.
+ */
+int checkpoint(hvc_s * hvcs);
+void rollback(hvc_s * hvcs, int cp);
+
+
 /* -------- others --------*/
 // TODO
 // hvc_s * copy(hvc_s * hvcs);
@@ -1,32 +1,114 @@
 #ifndef HVC_P_H_
 #define HVC_P_H_
 
+#if __GNUC__ >= 3
+# define __dlnode_aligned(a) __attribute__ ((aligned (a)))
+#else
+# define __dlnode_aligned(a) /* no 'aligned' attribute available */
+#endif
+
+#define DLNODE_ALIGNMENT 64
 
+/* The node is laid out so that the fields touched by the 3D sweeps (hvc3d,
+ * oneContribution3d, updateContributions) fill the first two cache lines and
+ * the linked lists the third one. Fields that are only needed by the 4D
+ * algorithms or by the bookkeeping in hvc-class live in a parallel array of
+ * dlnode_cold_t (see coldNode).
+ */
 typedef struct dlnode {
   double x[4];                    // The data vector              
   struct dlnode * closest[2]; // closest[0] == cx, closest[1] == cy
   struct dlnode * cnext[2]; //current next
+
   struct dlnode * head[2]; //lowest (0 - x, 1 - y)
-  
   double area;
   double volume;
   double lastSlicez;
+  double oldvolume; //HVC-ONLY 4D-U-ADD 
+  struct dlnode * domr; //dominator
+  int ndomr;    //number of dominators
+  int enabled;
   
   struct dlnode * next[4]; //keeps the points sorted according to coordinates 2,3 and 4 (in the case of 2 and 3, only the points swept by 4 are kept)
   struct dlnode *prev[4]; //keeps the points sorted according to coordinates 2 and 3 (excepto o sentinela 3)
   
   //prev[0] and next[0] are used to keep a history of the order in which points were added to the list
   
+} __dlnode_aligned(DLNODE_ALIGNMENT) dlnode_t;
+
+typedef struct dlnode_cold {
   double hvolume; //4D
-  int ndomr;    //number of dominators
-  struct dlnode * domr; //dominator
   int id;
-  
-  double oldvolume; //HVC-ONLY 4D-U-ADD 
+} dlnode_cold_t;
 
-  int enabled;
-  
-} dlnode_t;
+/* The nodes (sentinels included) are allocated by setup_cdllist in a single
+ * block that is preceded by this header, so the cold part of a node can be
+ * reached from the list head and the position of the node in the block.
+ */
+typedef struct dlarena {
+  dlnode_cold_t * cold;
+  struct dltrail * trail; //NULL when changes are not being recorded
+  int naloc;
+} __dlnode_aligned(DLNODE_ALIGNMENT) dlarena_t;
+
+static inline dlarena_t * arenaOf(dlnode_t * list){
+  return (dlarena_t *) list - 1;
+}
+
+static inline dlnode_cold_t * coldNode(dlnode_t * list, dlnode_t * p){
+  return arenaOf(list)->cold + (p - list);
+}
+
+
+/* Change trail. While a trail is attached to the arena, every write to the
+ * fields that define the structure (links, closest, ndomr, domr, enabled, id)
+ * records the previous value, and nodes that are removed are saved as a whole
+ * because their slot may be reused. Undoing the trail down to a given size
+ * restores the structure as it was at that size. The remaining fields (area,
+ * volume, cnext, head, ...) are recomputed by the sweeps and are not recorded.
+ */
+#define TRAIL_LINK 0
+#define TRAIL_INT  1
+#define TRAIL_NODE 2
+
+typedef struct dltrailentry {
+  void * addr;
+  union {
+    struct dlnode * link;
+    int value;
+    int image; //position in the images of the trail (TRAIL_NODE)
+  } old;
+  int kind;
+} dltrailentry_t;
+
+typedef struct dltrail {
+  dltrailentry_t * entries;
+  int size;
+  int naloc;
+
+  char * images; //copies of dlnode_t (not aligned as dlnode_t)
+  dlnode_cold_t * coldimages;
+  int nimages;
+  int nimagesaloc;
+} dltrail_t;
+
+void trailPush(dltrail_t * trail, void * addr, int kind);
+void trailPushNode(dlnode_t * list, dltrail_t * trail, dlnode_t * p);
+void trailUndo(dlnode_t * list, dltrail_t * trail, int size);
+
+static inline void setLink(dlnode_t * list, dlnode_t ** field, dlnode_t * value){
+  if(arenaOf(list)->trail) trailPush(arenaOf(list)->trail, field, TRAIL_LINK);
+  *field = value;
+}
+
+static inline void setInt(dlnode_t * list, int * field, int value){
+  if(arenaOf(list)->trail) trailPush(arenaOf(list)->trail, field, TRAIL_INT);
+  *field = value;
+}
+
+static inline void saveNode(dlnode_t * list, dlnode_t * p){
+  if(arenaOf(list)->trail) trailPushNode(list, arenaOf(list)->trail, p);
+}
 
 
 int preprocessing(dlnode_t * list); //returns the number of dominated points found
@@ -38,7 +120,7 @@ void removeFromDataStructure(dlnode_t * list, dlnode_t * old);
 
 dlnode_t * point2Struct(dlnode_t * list, dlnode_t * p, double * v, int d);
 void addToHistory(dlnode_t * list, dlnode_t * newp);
-void removeFromHistory(dlnode_t * oldp);
+void removeFromHistory(dlnode_t * list, dlnode_t * oldp);
 
 double oneContribution3d(dlnode_t * list, dlnode_t * new); //private
 double hv3dplus(dlnode_t * list); //private
@@ -96,8 +96,8 @@ void addToHistory(dlnode_t * list, dlnode_t * newp){
     newp->next[0] = list;
     newp->prev[0] = list->prev[0];
     
-    list->prev[0] = newp;
-    newp->prev[0]->next[0] = newp;
+    setLink(list, &list->prev[0], newp);
+    setLink(list, &newp->prev[0]->next[0], newp);
 }
 
 
@@ -105,9 +105,9 @@ void addToHistory(dlnode_t * list, dlnode_t * newp){
  * Assumes oldp is not in the hvc data structure (no 'closest' is pointing
  * to oldp nor any 'next[i]'/'prev[i]', for i > 2.)
  */
-void removeFromHistory(dlnode_t * oldp){
-    oldp->prev[0]->next[0] = oldp->next[0];
-    oldp->next[0]->prev[0] = oldp->prev[0];
+void removeFromHistory(dlnode_t * list, dlnode_t * oldp){
+    setLink(list, &oldp->prev[0]->next[0], oldp->next[0]);
+    setLink(list, &oldp->next[0]->prev[0], oldp->prev[0]);
 }
 
 
@@ -141,7 +141,7 @@ static dlnode_t * initSentinels(dlnode_t * list, const double * ref, int d){
     s1->prev[3] = s3;
     s1->ndomr = 0;
     s1->domr = NULL; //HVC-ONLY
-    s1->id = -1;  //HVC-ONLY
+    coldNode(list, s1)->id = -1;  //HVC-ONLY
     
     
     s2->x[0] = ref[0];
@@ -164,7 +164,7 @@ static dlnode_t * initSentinels(dlnode_t * list, const double * ref, int d){
     s2->prev[3] = s1;
     s2->ndomr = 0;
     s2->domr = NULL; //HVC-ONLY
-    s2->id = -2; //HVC-ONLY
+    coldNode(list, s2)->id = -2; //HVC-ONLY
     
     
     s3->x[0] = -INT_MAX;
@@ -190,7 +190,7 @@ static dlnode_t * initSentinels(dlnode_t * list, const double * ref, int d){
     s3->prev[3] = s2;
     s3->ndomr = 0;
     s3->domr = NULL; //HVC-ONLY
-    s3->id = -3; //HVC-ONLY
+    coldNode(list, s3)->id = -3; //HVC-ONLY
     
     
     return s1;
@@ -217,7 +217,7 @@ static void clearPoint(dlnode_t * list, dlnode_t * p){
     p->area = 0; //HVC-ONLY
     p->volume = 0; //HVC-ONLY
     p->oldvolume = 0; //HVC-ONLY 4D-U-ADD
-    p->hvolume = 0; //HVC-ONLY 4D
+    coldNode(list, p)->hvolume = 0; //HVC-ONLY 4D
     p->lastSlicez = p->x[2]; //HVC-ONLY
     p->ndomr = 0;
     p->domr = NULL; //HVC-ONLY
@@ -242,19 +242,19 @@ dlnode_t * point2Struct(dlnode_t * list, dlnode_t * p, double * v, int d){
 
 
 
-static void addToZ(dlnode_t * new){
+static void addToZ(dlnode_t * list, dlnode_t * new){
     
     new->next[2] = new->prev[2]->next[2]; //in case new->next[2] was removed for being dominated
     
-    new->next[2]->prev[2] = new;
-    new->prev[2]->next[2] = new;
+    setLink(list, &new->next[2]->prev[2], new);
+    setLink(list, &new->prev[2]->next[2], new);
 }
 
 
-static void removeFromz(dlnode_t * old){
+static void removeFromz(dlnode_t * list, dlnode_t * old){
     
-    old->prev[2]->next[2] = old->next[2];
-    old->next[2]->prev[2] = old->prev[2];
+    setLink(list, &old->prev[2]->next[2], old->next[2]);
+    setLink(list, &old->next[2]->prev[2], old->prev[2]);
 }
 
 
@@ -318,7 +318,7 @@ static void setupZandClosest(dlnode_t * list, dlnode_t * new){
 int addToDataStructure(dlnode_t * list, dlnode_t * new, int determineInsertionPoints){
 
     if(determineInsertionPoints) setupZandClosest(list, new);
-    addToZ(new);
+    addToZ(list, new);
     
     dlnode_t * p = new->next[2];
     dlnode_t * stop = list->prev[2];
@@ -333,21 +333,21 @@ int addToDataStructure(dlnode_t * list, dlnode_t * new, int determineInsertionPo
                 if(new->x[0] <= p->x[0]){
                     //new <= p
                     if(new->x[1] <= p->x[1]){
-                        p->ndomr++;
-                        p->domr = new; //HVC-ONLY 4D
+                        setInt(list, &p->ndomr, p->ndomr + 1);
+                        setLink(list, &p->domr, new); //HVC-ONLY 4D
                         ndom += 1;
     //                     removeFromz(p); //HV-ONLY (does not need dominated to compute HV)
                         
                     }else if(new->x[0] < p->x[0] && (new->x[1] < p->closest[1]->x[1] || (new->x[1] == p->closest[1]->x[1] && (new->x[0] < p->closest[1]->x[0] || (new->x[0] == p->closest[1]->x[0] && new->x[2] < p->closest[1]->x[2]))))){
-                        p->closest[1] = new;
+                        setLink(list, &p->closest[1], new);
                     }
                 }else if(new->x[1] < p->x[1] && (new->x[0] < p->closest[0]->x[0] || (new->x[0] == p->closest[0]->x[0] && (new->x[1] < p->closest[0]->x[1] || (new->x[1] == p->closest[0]->x[1] && new->x[2] < p->closest[0]->x[2]))))){
-                    p->closest[0] = new;
+                    setLink(list, &p->closest[0], new);
                 }
                 
                 
                 if(p->ndomr > 1){ //HVC-ONLY 4D
-                    removeFromz(p); //HVC-ONLY 4D
+                    removeFromz(list, p); //HVC-ONLY 4D
                 }
             }
         }
@@ -408,7 +408,21 @@ setup_cdllist(double * data, int naloc, int n, int d, double *ref)
 {
     int di = d-1;
     
-    dlnode_t * head = (dlnode_t *) malloc((naloc+3) * sizeof(dlnode_t));
+    void * block = NULL;
+    if(posix_memalign(&block, DLNODE_ALIGNMENT, sizeof(dlarena_t) + (naloc+3) * sizeof(dlnode_t)))
+        return NULL;
+
+    dlarena_t * arena = (dlarena_t *) block;
+    arena->cold = (dlnode_cold_t *) calloc(naloc+3, sizeof(dlnode_cold_t));
+    if(arena->cold == NULL){
+        free(block);
+        return NULL;
+    }
+
+    arena->naloc = naloc;
+    arena->trail = NULL;
+
+    dlnode_t * head = (dlnode_t *) (arena + 1);
 
     for(dlnode_t *it = head; it != head + naloc+3; ++it)
         it->enabled = 0;
@@ -445,8 +459,8 @@ setup_cdllist(double * data, int naloc, int n, int d, double *ref)
         
         for (i = 0; i < n; i++) {
             scratch[i] = point2Struct(list, head+i+3, &data2[i*d], d);
-            scratch[i]->id = (scratchd[i]-data)/d;
-            originalOrder[scratch[i]->id+1] = scratch[i];
+            coldNode(list, scratch[i])->id = (scratchd[i]-data)/d;
+            originalOrder[coldNode(list, scratch[i])->id+1] = scratch[i];
         }
         
         free(scratchd);
@@ -492,7 +506,68 @@ setup_cdllist(double * data, int naloc, int n, int d, double *ref)
 
 void free_cdllist(dlnode_t * list)
 {
-    free(list);
+    dlarena_t * arena = (dlarena_t *) list - 1;
+    free(arena->cold);
+    free(arena);
+}
+
+
+
+/* ---------------------------------- Change trail ---------------------------------------*/
+
+
+void trailPush(dltrail_t * trail, void * addr, int kind){
+    
+    if(trail->size == trail->naloc){
+        trail->naloc = (trail->naloc > 0) ? 2 * trail->naloc : 256;
+        trail->entries = (dltrailentry_t *) realloc(trail->entries, trail->naloc * sizeof(dltrailentry_t));
+    }
+    
+    dltrailentry_t * e = trail->entries + trail->size++;
+    e->addr = addr;
+    e->kind = kind;
+    if(kind == TRAIL_LINK)
+        e->old.link = *((dlnode_t **) addr);
+    else
+        e->old.value = *((int *) addr);
+}
+
+
+
+void trailPushNode(dlnode_t * list, dltrail_t * trail, dlnode_t * p){
+    
+    if(trail->nimages == trail->nimagesaloc){
+        trail->nimagesaloc = (trail->nimagesaloc > 0) ? 2 * trail->nimagesaloc : 16;
+        trail->images = (char *) realloc(trail->images, trail->nimagesaloc * sizeof(dlnode_t));
+        trail->coldimages = (dlnode_cold_t *) realloc(trail->coldimages, trail->nimagesaloc * sizeof(dlnode_cold_t));
+    }
+    
+    memcpy(trail->images + trail->nimages * sizeof(dlnode_t), p, sizeof(dlnode_t));
+    trail->coldimages[trail->nimages] = *coldNode(list, p);
+    
+    trailPush(trail, p, TRAIL_NODE);
+    trail->entries[trail->size-1].old.image = trail->nimages++;
+}
+
+
+
+/* Undoes the recorded changes, from the most recent one, until only 'size' remain */
+void trailUndo(dlnode_t * list, dltrail_t * trail, int size){
+    
+    while(trail->size > size){
+        dltrailentry_t * e = trail->entries + --trail->size;
+        
+        if(e->kind == TRAIL_LINK){
+            *((dlnode_t **) e->addr) = e->old.link;
+        }else if(e->kind == TRAIL_INT){
+            *((int *) e->addr) = e->old.value;
+        }else{
+            dlnode_t * p = (dlnode_t *) e->addr;
+            memcpy(p, trail->images + e->old.image * sizeof(dlnode_t), sizeof(dlnode_t));
+            *coldNode(list, p) = trail->coldimages[e->old.image];
+            trail->nimages = e->old.image;
+        }
+    }
 }
 
 
@@ -878,7 +953,7 @@ double hvc4dR(dlnode_t * list)
         volume = hvc3d(list, considerDominated);  // compute hv indicator and contributions in d=3, in linear time 
         p = list->next[2]->next[2];
         while(p != stop){
-            p->hvolume += p->volume * (new->next[3]->x[3] - new->x[3]);
+            coldNode(list, p)->hvolume += p->volume * (new->next[3]->x[3] - new->x[3]);
             p = p->next[2];
         }
         
@@ -1300,8 +1375,8 @@ static void restartBaseSetupZandClosest(dlnode_t * list, dlnode_t * new){
                 closest1 = (double *) p;
             }
         }else{ //HVC-ONLY 4D-U-ADD
-            p->prev[2]->next[2] = p->next[2]; //HVC-ONLY 4D-U-ADD
-            p->next[2]->prev[2] = p->prev[2]; //HVC-ONLY 4D-U-ADD
+            setLink(list, &p->prev[2]->next[2], p->next[2]); //HVC-ONLY 4D-U-ADD
+            setLink(list, &p->next[2]->prev[2], p->prev[2]); //HVC-ONLY 4D-U-ADD
         } //HVC-ONLY 4D-U-ADD
         
         p = p->next[2];
@@ -1358,7 +1433,7 @@ static void addPoint(dlnode_t * p){
 
 /* compute the area dominated by every delimiter of new's contribution in L
  * and by new and assign it to the corresponding delimiter */
-static void restartCoveredAreas(dlnode_t * new){
+static void restartCoveredAreas(dlnode_t * list, dlnode_t * new){
     dlnode_t * q = new->cnext[0];
     dlnode_t * l2;
     
@@ -1379,7 +1454,7 @@ static void restartCoveredAreas(dlnode_t * new){
         l2 = q->head[1];
         q->area = computeArea(q->x, 1, q->cnext[0], l2, q->cnext[1]);
         q->lastSlicez = new->x[2];    
-        q->domr = new;
+        setLink(list, &q->domr, new);
         
         q = q->cnext[1];
     }
@@ -1641,7 +1716,7 @@ double updateContributions(dlnode_t * list, dlnode_t * new, int adding){
     new->head[0] = new->closest[1]->cnext[0];
     new->lastSlicez = new->x[2];
     
-    restartCoveredAreas(new);
+    restartCoveredAreas(list, new);
     //new->oldvolume = new->volume; //it is not really necessary
     new->volume = 0;
     new->area = computeArea(new->x, 1, new->closest[0], new->closest[0]->cnext[1], new->closest[1]);
@@ -1771,7 +1846,7 @@ double hvc4dU(dlnode_t * list){
         //if(new->ndomr == 1) new->ndomr = 2;
         p = list->next[2]->next[2];
         while(p != stop){
-            p->hvolume += p->volume * (new->next[3]->x[3] - new->x[3]);
+            coldNode(list, p)->hvolume += p->volume * (new->next[3]->x[3] - new->x[3]);
             p = p->next[2];
         }
         
@@ -1799,7 +1874,7 @@ static void saveContributions(dlnode_t * list, double * contribs, int d){
         }
     }else if(d == 4){
         for(i = 0; p != list; i++, p = p->next[0]){
-            contribs[i] = p->hvolume;
+            contribs[i] = coldNode(list, p)->hvolume;
         }
     }
 }
@@ -1813,9 +1888,9 @@ static void saveContributions(dlnode_t * list, double * contribs, int d){
     p = list->next[d-1]->next[d-1];
     while(p != last){
         if(d == 3)
-            contribs[p->id] = p->volume;
+            contribs[coldNode(list, p)->id] = p->volume;
         else if(d == 4)
-            contribs[p->id] = p->hvolume;
+            contribs[coldNode(list, p)->id] = coldNode(list, p)->hvolume;
         p = p->next[d-1];
     }
 }*/
@@ -1881,7 +1956,7 @@ static dlnode_t * leastContributor(dlnode_t * list, int d){
 
 
 
-static int updateInsertingPoints(dlnode_t * old, dlnode_t * p, int di){
+static int updateInsertingPoints(dlnode_t * list, dlnode_t * old, dlnode_t * p, int di){
     
     if(p->closest[di] == old){
         int dj = 1 - di;
@@ -1890,9 +1965,9 @@ static int updateInsertingPoints(dlnode_t * old, dlnode_t * p, int di){
             while(q->x[dj] >= p->x[dj]){
                 q = q->cnext[di];
             }
-            p->closest[di] = q;
+            setLink(list, &p->closest[di], q);
         }else{
-            p->closest[di] = old->cnext[di];
+            setLink(list, &p->closest[di], old->cnext[di]);
         }
         return 1;
     }
@@ -1920,10 +1995,10 @@ void removeFromDataStructure(dlnode_t * list, dlnode_t * old){
     while(p != stop){
 
         if(old->x[0] <= p->x[0] && old->x[1] <= p->x[1]){
-            p->ndomr--; //this should never happen... we assumed that a nondominated point is removed
+            setInt(list, &p->ndomr, p->ndomr - 1); //this should never happen... we assumed that a nondominated point is removed
                         //only if there is not any dominated points in the data structure
             
-        }else if(updateInsertingPoints(old, p, 0)){
+        }else if(updateInsertingPoints(list, old, p, 0)){
             old->cnext[1] = p;
             if(p->closest[0]->x[1] >= old->x[1]){ //if updateInsertingPoints == True then p->closest[0]->x[0] >= old->x[0]
                 old->head[0] = p->closest[0];
@@ -1932,7 +2007,7 @@ void removeFromDataStructure(dlnode_t * list, dlnode_t * old){
                 old->head[1] = old->cnext[1];
             }
         }else{
-            if(updateInsertingPoints(old, p, 1)){
+            if(updateInsertingPoints(list, old, p, 1)){
 
                 old->cnext[0] = p;
                 if(p->closest[1]->x[0] >= old->x[0]){  //if updateInsertingPoints == True then p->closest[1]->x[1] >= old->x[1]
@@ -1947,7 +2022,7 @@ void removeFromDataStructure(dlnode_t * list, dlnode_t * old){
         p = p->next[2];
     }
     
-    removeFromz(old);
+    removeFromz(list, old);
     
 }
 
@@ -1970,7 +2045,7 @@ static double gHSSD3D(dlnode_t * list, int n, int k, double * contribs, int * se
     for(ki = n-1; ki >= k; ki--){
         lcontributor = leastContributor(list, 3);
 
-        selected[ki] = lcontributor->id;
+        selected[ki] = coldNode(list, lcontributor)->id;
         contribs[ki] = lcontributor->volume; // assumes d == 3
 
         hv -= lcontributor->volume;
@@ -1983,13 +2058,13 @@ static double gHSSD3D(dlnode_t * list, int n, int k, double * contribs, int * se
             updateContributions(list, lcontributor, adding);
         }
         
-        removeFromHistory(lcontributor);
+        removeFromHistory(list, lcontributor);
         //times[ki] = Timer_elapsed_virtual();
     }
     
     dlnode_t * p = list->prev[0];
     for(ki = k-1; ki >= 0; ki--){
-        selected[ki] = p->id;
+        selected[ki] = coldNode(list, p)->id;
         contribs[ki] = p->volume;
         p = p->prev[0];
         //times[ki] = 0;
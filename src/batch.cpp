@@ -0,0 +1,208 @@
+#include "batch.h"
+
+// instances shared by the reader, the solvers and the printer of a batch. an instance is kept from
+// the time it is read until it is printed
+struct Batch {
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<Instance> instances;
+	long int first = 0, next = 0; // index of the first instance kept and of the next one to solve
+	long int window;              // number of instances kept at most
+	bool read = false;            // every instance has been read
+	std::string error;            // the file that could not be read, which ends the reading
+};
+
+// waits for the condition. the condition is also checked every 100 ms, since a cancel from a signal
+// handler can not notify
+template <typename Condition> void wait(std::unique_lock<std::mutex> &lock, Batch &batch, Condition condition){
+	while(!condition())
+		batch.cv.wait_for(lock, milliseconds(100));
+}
+
+// reads the next point set of a stream. sets are separated by blank or comment lines, as in the
+// files of the hvc tool, and their lines are parsed as those of an input file. a point with text that
+// is not a number gives the set an error instead of a point with fewer coordinates
+bool read_instance(std::istream &stream, Instance &instance){
+	std::string line;
+	std::vector<double> point;
+
+	while(std::getline(stream, line)){
+		const bool valid = parse_line(line, point);
+
+		if(point.empty() && valid && (instance.points.size() || !instance.result.error.empty()))
+			return true;
+
+		if(!valid && instance.result.error.empty())
+			instance.result.error = "invalid number in point " + std::to_string(instance.points.size() + 1) + "\n";
+		if(!point.empty())
+			instance.points.push_back(std::move(point));
+
+		point.clear();
+	}
+
+	return instance.points.size() || !instance.result.error.empty();
+}
+
+// reads the instances of each file in order. the standard input is read for '-'. a file that can not
+// be opened or read, such as a directory, ends the reading after the instances read before it
+void read_instances(std::vector<std::string> files, std::shared_ptr<Batch> batch, CancelToken *cancel){
+	for(const std::string &path : files){
+		std::ifstream file;
+		if(path != "-")
+			file.open(path, std::ifstream::in);
+
+		std::istream &stream = path == "-" ? std::cin : file;
+		Instance instance;
+
+		while(stream.good() && !cancel->cancelled() && read_instance(stream, instance)){
+			std::unique_lock<std::mutex> lock(batch->mtx);
+			wait(lock, *batch, [&](){ return (long int) batch->instances.size() < batch->window || cancel->cancelled(); });
+
+			batch->instances.push_back(std::move(instance));
+			batch->cv.notify_all();
+			instance = Instance();
+		}
+
+		if((path != "-" && !file.is_open()) || stream.bad()){
+			std::lock_guard<std::mutex> lguard(batch->mtx);
+			batch->error = "could not read file '" + path + "'\n";
+			break;
+		}
+	}
+
+	std::lock_guard<std::mutex> lguard(batch->mtx);
+	batch->read = true;
+	batch->cv.notify_all();
+}
+
+// solves the instances in the order they were read, one at a time, until there are no more
+void solve_instances(std::shared_ptr<Batch> batch, const std::vector<double> &ref, const SolveOptions &options){
+	std::unique_lock<std::mutex> lock(batch->mtx);
+
+	while(!options.cancel->cancelled()){
+		if(batch->next < batch->first + (long int) batch->instances.size()){
+			Instance &instance = batch->instances[batch->next++ - batch->first];
+
+			// a set with an invalid point keeps the error of its reader
+			if(instance.result.error.empty()){
+				lock.unlock();
+				SolveResult result = solve(instance.points, ref, options);
+				lock.lock();
+
+				instance.result = std::move(result);
+			}
+
+			// a set whose solve was cancelled is not printed
+			instance.solved = instance.result.optimal || !instance.result.error.empty();
+			batch->cv.notify_all();
+		}
+		else if(batch->read)
+			break;
+		else
+			wait(lock, *batch, [&](){ return batch->next < batch->first + (long int) batch->instances.size() || batch->read || options.cancel->cancelled(); });
+	}
+}
+
+// prints the result of an instance as the program prints the result of a single file. an instance
+// that can not be solved prints the first line of its error instead
+void print_instance(const Instance &instance, long int index){
+	const SolveResult &result = instance.result;
+
+	if(!result.error.empty()){
+		std::cout << "hssp: instance " << index + 1 << ": " << result.error.substr(0, result.error.find('\n')) << "\n\n";
+		return;
+	}
+
+	std::cout << std::scientific << std::setprecision(15) << result.volume << "\n";
+	for(int p : result.solution)
+		std::cout << p << " ";
+
+	std::cout << "\n";
+}
+
+// solves every instance of the input files, or of the standard input when no file is given, on a
+// pool of -j threads that each solve one instance at a time. the results are printed in the order of
+// the instances as soon as they are known. returns false when the options are invalid or a file can
+// not be read
+bool run_batch(std::vector<std::string> args, CancelToken *cancel, bool *stopped){
+	Problem P {};
+	std::ifstream file;
+	std::vector<double> ref;
+
+	P.cancel = cancel;
+	*stopped = false;
+	init_problem(&P);
+
+	if(!read_args(args, ref, file, &P))
+		return false;
+
+	SolveOptions options;
+	options.k = P.k;
+	options.maximize = P.maximize;
+	options.deterministic = P.deterministic;
+	options.cancel = cancel;
+
+	std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+	std::vector<std::thread> solvers;
+	std::vector<std::string> files(P.input_files);
+
+	batch->window = 16l * P.cores;
+	if(files.empty())
+		files.push_back("-");
+
+	std::thread reader(read_instances, files, batch, cancel);
+	for(int t = 0; t < P.cores; ++t)
+		solvers.push_back(std::thread(solve_instances, batch, std::cref(ref), std::cref(options)));
+
+	std::unique_lock<std::mutex> lock(batch->mtx);
+
+	while(!cancel->cancelled() && !(batch->read && batch->instances.empty())){
+		if(batch->instances.empty() || !batch->instances.front().solved){
+			std::cout.flush();
+			wait(lock, *batch, [&](){ return (batch->instances.size() && batch->instances.front().solved) || (batch->read && batch->instances.empty()) || cancel->cancelled(); });
+			continue;
+		}
+
+		const Instance instance = std::move(batch->instances.front());
+		const long int index = batch->first++;
+
+		batch->instances.pop_front();
+		batch->cv.notify_all();
+
+		lock.unlock();
+		print_instance(instance, index);
+		lock.lock();
+	}
+
+	lock.unlock();
+	for(std::thread &t : solvers)
+		t.join();
+	lock.lock();
+
+	// a cancelled batch still prints the instances solved before the first one that was not
+	for(const Instance &instance : batch->instances){
+		if(!instance.solved)
+			break;
+
+		print_instance(instance, batch->first++);
+	}
+
+	const bool read = batch->read;
+	const std::string error = batch->error;
+	lock.unlock();
+
+	if(!error.empty())
+		std::cout << "hssp: " << error;
+
+	std::cout.flush();
+	*stopped = cancel->cancelled();
+
+	// the reader may be blocked on the standard input after a cancel
+	if(read)
+		reader.join();
+	else
+		reader.detach();
+
+	clear_memory(&P);
+	return error.empty();
+}
@@ -0,0 +1,29 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "util.h"
+#include "hssp.h"
+#include "solver.h"
+#include "parser.h"
+
+#include <string>             // string, getline
+#include <vector>             // vector
+#include <deque>              // deque
+#include <fstream>            // ifstream
+#include <iostream>           // cin, cout
+#include <iomanip>            // setprecision
+#include <mutex>              // mutex, unique_lock
+#include <condition_variable> // condition_variable
+#include <thread>             // thread
+#include <memory>             // shared_ptr, make_shared
+
+// point set of a batch and the result of its solve
+struct Instance {
+	std::vector<std::vector<double> > points;
+	SolveResult result;
+	bool solved = false;
+};
+
+bool run_batch(std::vector<std::string> , CancelToken * , bool * );
+
+#endif
@@ -0,0 +1,279 @@
+#include "bench.h"
+
+// results of the operations, kept so that they are not optimized away
+volatile double sink__ = 0.0;
+
+// generated front normalized to the reference point "1 ... 1", which becomes the origin
+void init_front(Front &F, int n, int dim, int k, const BenchOptions &O){
+	const std::vector<std::vector<double> > points = generate_front(O.front, n, dim, O.seed + dim);
+	Problem *P = &F.P;
+
+	P->n = n;
+	P->dim = dim;
+	P->k = k;
+	P->best = 0.0;
+	P->cores = 1;
+	P->ref = new double[dim]();
+	P->X = new_points(n, dim, true);
+
+	for(int i = 0; i < n; ++i)
+		for(int d = 0; d < dim; ++d)
+			P->X[i].values[d] = points[i][d] - 1.0;
+
+	F.C.resize(n);
+	F.Ce.resize(n);
+	F.Cr.resize(n);
+}
+
+// contributions of the root of the search, which the bounds start from
+void init_root(Front &F){
+	root_contributions(F.C.data(), F.Cr.data(), &F.P);
+	F.Ce = F.Cr;
+}
+
+// runs the operation in samples of the same number of operations, which is the number that takes at
+// least the sample time. with '--counters' the events of the samples are also counted
+BenchResult measure(const std::function<void()> &op, const BenchOptions &O){
+	BenchResult result {0.0, 0.0, INF, 1, {}, {}};
+	CounterGroup group(O.counters);
+	double before[EVENTS], after[EVENTS];
+	std::vector<double> times;
+
+	while(true){
+		const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		for(long int i = 0; i < result.ops; ++i)
+			op();
+
+		const duration<double> elapsed = high_resolution_clock::now() - t0;
+		if(elapsed.count() >= O.sample_time || result.ops >= (1l << 40))
+			break;
+
+		result.ops *= 2;
+	}
+
+	for(int s = 0; s < O.samples; ++s){
+		group.read(before);
+		const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		for(long int i = 0; i < result.ops; ++i)
+			op();
+
+		const duration<double, std::nano> elapsed = high_resolution_clock::now() - t0;
+		group.read(after);
+		times.push_back(elapsed.count() / result.ops);
+
+		for(int e = 0; e < EVENTS; ++e)
+			result.events[e] += (after[e] - before[e]) / result.ops / O.samples;
+	}
+
+	for(int e = 0; e < EVENTS; ++e)
+		result.counted[e] = group.counts(e);
+
+	for(double t : times){
+		result.mean += t / times.size();
+		result.min = std::min(result.min, t);
+	}
+	for(double t : times)
+		result.stddev += (t - result.mean) * (t - result.mean) / std::max<int>(1, times.size() - 1);
+
+	result.stddev = std::sqrt(result.stddev);
+	return result;
+}
+
+// measures a kernel unless the filter leaves it out, and prints one tab separated line with its time
+void report(const std::string &kernel, const Front &F, const std::function<void()> &op, const BenchOptions &O){
+	if(kernel.find(O.filter) == std::string::npos)
+		return;
+
+	const BenchResult r = measure(op, O);
+	std::cout << kernel << "\t" << F.P.dim << "\t" << F.P.n << "\t" << F.P.k << "\t" << O.samples << "\t" << r.ops << "\t";
+	std::cout << std::fixed << std::setprecision(1) << r.mean << "\t" << r.stddev << "\t" << r.min;
+
+	// events that could not be counted are printed as '-'
+	for(int e = 0; O.counters && e < EVENTS; ++e){
+		if(r.counted[e])
+			std::cout << "\t" << r.events[e];
+		else
+			std::cout << "\t-";
+	}
+	if(O.counters && r.counted[EVENT_CYCLES] && r.counted[EVENT_INSTRUCTIONS] && r.events[EVENT_CYCLES] > 0)
+		std::cout << "\t" << std::setprecision(2) << r.events[EVENT_INSTRUCTIONS] / r.events[EVENT_CYCLES];
+	else if(O.counters)
+		std::cout << "\t-";
+
+	std::cout << std::endl;
+}
+
+bool wanted(const std::vector<std::string> &kernels, const BenchOptions &O){
+	for(const std::string &kernel : kernels)
+		if(kernel.find(O.filter) != std::string::npos)
+			return true;
+
+	return false;
+}
+
+// kernels of the incremental 3d contributions, on the subset of the first k points and the rest
+void bench_3d(Front &F, const BenchOptions &O){
+	Problem *P = &F.P;
+	Point *subset = P->X, *rest = P->X + P->k, aux1[P->n];
+	const int others = P->n - P->k;
+	std::vector<double> out(P->n), data(P->k * P->dim);
+	int next = 0;
+
+	report("get_contributions", F, [&](){
+		get_contributions(rest, subset, P->k, others, P->dim, P->ref, out.data());
+		sink__ = out[0];
+	}, O);
+
+	flatten_set(subset, data.data(), P->k, 1, P->dim);
+	hvc_s *hvcs = init(data.data(), P->dim, P->k, P->n, P->ref);
+	if(!hvcs)
+		throw std::bad_alloc();
+
+	report("update_contributions", F, [&](){
+		update_contributions(rest, others, hvcs, out.data());
+		sink__ = out[0];
+	}, O);
+
+	report("one_contribution", F, [&](){
+		sink__ = oneContribution(hvcs, rest[next++ % others].values);
+	}, O);
+
+	// a point is removed right after it is added, so the structure keeps its size
+	report("add_remove_point", F, [&](){
+		double *p = rest[next++ % others].values;
+		addPoint(hvcs, p, 0);
+		sink__ = removePoint(hvcs, p, 0);
+	}, O);
+
+	dealloc(hvcs);
+
+	report("build", F, [&](){
+		hvc_s *full = build(rest, subset, aux1, P->k, others, P->n, P->dim, P->ref, true);
+		sink__ = dealloc(full);
+	}, O);
+}
+
+// bounds of the root of the search, where they consider every point
+void bench_bounds(Front &F, const BenchOptions &O){
+	Problem *P = &F.P;
+	Point S[P->n], subset[P->k], aux1[P->n];
+	double aux2[P->n];
+
+	init_root(F);
+	std::copy(P->X, P->X + P->n, S);
+	std::copy(P->X, P->X + P->n, aux1);
+	const double hs = hypervolume(aux1, P->n, P->dim, P->ref);
+	hvc_s *full = build(S, subset, aux1, 0, P->n, P->n, P->dim, P->ref, true);
+
+	report("bound1", F, [&](){
+		double ubound1 = hs;
+		sink__ = bound1(S, subset, aux1, F.Cr.data(), F.Ce.data(), aux2, ubound1, 0, P->n, 0, false, full, P);
+	}, O);
+
+	report("bound2", F, [&](){
+		double hv = 0.0;
+		sink__ = bound2(F.C.data(), aux2, hv, 0, P->n, 0, P);
+	}, O);
+
+	report("nth_subsetsum", F, [&](){
+		sink__ = nth_subsetsum(F.C.data(), P->n, P->k, P->n).size();
+	}, O);
+
+	if(full)
+		dealloc(full);
+}
+
+void run_benchmarks(const BenchOptions &O){
+	std::cout << "# kernel\tdim\tn\tk\tsamples\tops\tmean_ns\tstddev_ns\tmin_ns";
+	for(int e = 0; O.counters && e < EVENTS; ++e)
+		std::cout << "\t" << event_names__[e];
+	std::cout << (O.counters ? "\tipc" : "") << std::endl;
+
+	// without hardware counters the columns of the events are printed empty
+	const CounterGroup probe(O.counters);
+	bool counted = false;
+
+	for(int e = 0; e < EVENTS; ++e)
+		counted = counted || probe.counts(e);
+	if(O.counters && !counted)
+		logger::warn("hardware counters are not available, only the time of the kernels is measured");
+
+	// cliff fronts start at d=3
+	for(int dim = O.front == FRONT_CLIFF ? 3 : 2; dim <= 8; ++dim){
+		Front F;
+		init_front(F, dim > 5 ? O.high_n : O.n, dim, O.k, O);
+
+		report("hypervolume", F, [&](){
+			sink__ = hypervolume(F.P.X, F.P.n, F.P.dim, F.P.ref);
+		}, O);
+
+		if(dim == 3 || dim == 4){
+			report("all_contributions", F, [&](){
+				all_contributions(F.P.X, F.P.n, F.P.dim, F.P.ref, F.Ce.data());
+				sink__ = F.Ce[0];
+			}, O);
+		}
+
+		if(dim == 3)
+			bench_3d(F, O);
+
+		// bound1 has a different computation for d=3, for d=4 and for the other dimensions
+		if(dim >= 3 && dim <= 5 && wanted({"bound1", "bound2", "nth_subsetsum"}, O))
+			bench_bounds(F, O);
+
+		clear_memory(&F.P);
+	}
+}
+
+void bench_usage(){
+	std::cerr << "usage: hssp-bench [--filter KERNEL] [--front F] [-n N] [--high-n N] [-k K] [--samples N] [--time SECONDS] [--seed S] [--counters]" << std::endl;
+}
+
+int main(int argc, char **argv){
+	std::vector<std::string> args(argv+1, argv+argc);
+	BenchOptions O;
+
+	for(std::vector<std::string>::iterator it = args.begin(); it != args.end(); ++it){
+		const bool last = std::next(it) == args.end();
+		bool invalid = last;
+
+		if(*it == "--counters"){
+			O.counters = true;
+			invalid = false;
+		}
+		else if(*it == "--filter" && !last)
+			O.filter = *++it;
+		else if(*it == "--front" && !last)
+			invalid = !front_family(*++it, O.front);
+		else if(*it == "-n" && !last)
+			invalid = stoi__(&O.n, *++it);
+		else if(*it == "--high-n" && !last)
+			invalid = stoi__(&O.high_n, *++it);
+		else if(*it == "-k" && !last)
+			invalid = stoi__(&O.k, *++it);
+		else if(*it == "--samples" && !last)
+			invalid = stoi__(&O.samples, *++it);
+		else if(*it == "--time" && !last)
+			invalid = stod__(&O.sample_time, *++it);
+		else if(*it == "--seed" && !last){
+			int seed;
+			invalid = stoi__(&seed, *++it);
+			O.seed = seed;
+		}
+		else
+			invalid = true;
+
+		if(invalid){
+			bench_usage();
+			return 1;
+		}
+	}
+
+	if(O.k < 1 || O.n <= O.k || O.high_n <= O.k || O.samples < 1 || O.sample_time < 0){
+		logger::fail("the sizes must satisfy 1 <= k < n and the samples must be positive");
+		return 1;
+	}
+
+	run_benchmarks(O);
+	return 0;
+}
@@ -0,0 +1,46 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "util.h"
+#include "hssp.h"
+#include "hypervolume.h"
+#include "nth_subsetsum.h"
+#include "generator.h"
+#include "counters.h"
+
+#include <string>    // string, to_string
+#include <vector>    // vector
+#include <chrono>    // high_resolution_clock, duration
+#include <cmath>     // sqrt, fabs
+#include <iostream>  // cout, cerr
+#include <iomanip>   // setprecision
+#include <functional> // function
+
+using namespace std::chrono;
+
+// settings of a run of the benchmarks, given in the command line
+struct BenchOptions {
+	std::string filter;    // only the kernels whose name contains it are measured
+	int n = 100, k = 10, samples = 10;
+	int high_n = 30;           // points of the fronts of d>5, whose hypervolume grows fast with n
+	double sample_time = 0.05; // seconds spent at least in each sample
+	FrontFamily front = FRONT_CONCAVE;
+	unsigned int seed = 1;
+	bool counters = false;     // count the hardware events of the samples
+};
+
+// time of the samples of a kernel in nanoseconds per operation
+struct BenchResult {
+	double mean, stddev, min;
+	long int ops; // operations of each sample
+	double events[EVENTS]; // hardware events per operation with '--counters'
+	bool counted[EVENTS];
+};
+
+// normalized points of a front together with the problem the bounds are computed for
+struct Front {
+	Problem P {};
+	std::vector<double> C, Ce, Cr;
+};
+
+#endif
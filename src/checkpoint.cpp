@@ -0,0 +1,184 @@
+#include "checkpoint.h"
+
+const char checkpoint_magic__[8] = {'H', 'S', 'S', 'P', 'C', 'K', 'P', '1'};
+
+// FNV-1a hash of the normalized points. avoids resuming a search on a different set of points
+uint64_t problem_hash(Problem *P){
+	uint64_t hash = 14695981039346656037ull;
+	const unsigned char *it = (const unsigned char *) P->X->values;
+
+	for(size_t b = 0; b < sizeof(double) * P->n * P->dim; ++b)
+		hash = (hash ^ it[b]) * 1099511628211ull;
+
+	return hash;
+}
+
+long int total_nodes(Problem *P){
+	return total(P, &ThreadStats::nodes);
+}
+
+bool checkpoint_due(Problem *P){
+	if(cancelled(P) || (P->stop_after > 0 && total_nodes(P) >= P->stop_after))
+		return true;
+
+	const duration<double> elapsed = high_resolution_clock::now() - P->checkpoint_time;
+	return elapsed.count() >= P->checkpoint_interval;
+}
+
+Subproblem task_subproblem(const Task &task, Problem *P){
+	Subproblem sp;
+
+	for(Point *p = task.subset; p != task.subset + task.subset_size; ++p)
+		sp.accepted.push_back(point_index(p, P));
+	for(Point *p = task.S + task.cur_pos; p != task.S + P->n; ++p)
+		sp.remaining.push_back(point_index(p, P));
+
+	return sp;
+}
+
+void start_path(const Subproblem &sp, int id, Problem *P){
+	SearchPath &path = P->paths[id];
+
+	path.accepted = sp.accepted;
+	path.remaining = sp.remaining;
+	path.frames.clear();
+	path.active = true;
+}
+
+// the open subproblems of a thread are the ignore branches that are still to be explored along its
+// path, and the node where the thread currently is, which is explored again
+void path_frontier(SearchPath &path, std::vector<Subproblem> &open){
+	Subproblem sp {path.accepted, path.remaining};
+
+	for(const std::pair<int, bool> &frame : path.frames){
+		sp.remaining.erase(std::find(sp.remaining.begin(), sp.remaining.end(), frame.first));
+
+		if(frame.second){
+			open.push_back(sp);
+			sp.accepted.push_back(frame.first);
+		}
+	}
+
+	open.push_back(sp);
+}
+
+void write_bitset(std::ostream &stream, const std::vector<int> &positions, Problem *P){
+	std::vector<unsigned char> bits((P->n + 7) / 8, 0);
+
+	for(int pos : positions)
+		bits[pos / 8] |= 1 << (pos % 8);
+
+	stream.write((const char *) bits.data(), bits.size());
+}
+
+bool read_bitset(std::istream &stream, std::vector<int> &positions, Problem *P){
+	std::vector<unsigned char> bits((P->n + 7) / 8, 0);
+
+	if(!stream.read((char *) bits.data(), bits.size()))
+		return false;
+
+	for(int pos = 0; pos < P->n; ++pos)
+		if(bits[pos / 8] & (1 << (pos % 8)))
+			positions.push_back(pos);
+
+	return true;
+}
+
+// the subproblems are stored as two sets of initial positions of the points
+void write_subproblem(std::ostream &stream, const Subproblem &sp, Problem *P){
+	write_bitset(stream, sp.accepted, P);
+	write_bitset(stream, sp.remaining, P);
+}
+
+bool read_subproblem(std::istream &stream, Subproblem &sp, Problem *P){
+	return read_bitset(stream, sp.accepted, P) && read_bitset(stream, sp.remaining, P);
+}
+
+// NOTE: the caller must guarantee that no thread is changing the search in the meantime
+void save_checkpoint(std::vector<Task> &tasks, Problem *P){
+	std::vector<Subproblem> open;
+
+	for(const Task &task : tasks)
+		open.push_back(task_subproblem(task, P));
+	for(SearchPath &path : P->paths)
+		if(path.active)
+			path_frontier(path, open);
+
+	const long int nodes = total_nodes(P);
+	const std::string tmp_file = P->checkpoint_file + ".tmp";
+	std::ofstream file(tmp_file, std::ofstream::binary | std::ofstream::trunc);
+
+	file.write(checkpoint_magic__, sizeof(checkpoint_magic__));
+	write__(file, (int32_t) P->n);
+	write__(file, (int32_t) P->k);
+	write__(file, (int32_t) P->dim);
+	write__(file, problem_hash(P));
+	write__(file, P->best);
+	write__(file, (int64_t) nodes);
+	write__(file, (int64_t) total(P, &ThreadStats::tasks));
+
+	// there is no solution before the first one is found
+	write__(file, (int32_t) (P->best > -INF ? P->k : 0));
+	for(Point *p = P->solution; P->best > -INF && p != P->solution + P->k; ++p)
+		write__(file, (int32_t) point_index(p, P));
+
+	write__(file, (int64_t) open.size());
+	for(const Subproblem &sp : open)
+		write_subproblem(file, sp, P);
+
+	file.close();
+
+	// replace the previous checkpoint only when the new one is complete
+	if(!file.good() || std::rename(tmp_file.c_str(), P->checkpoint_file.c_str()))
+		logger::warn("failed to write checkpoint file '" + P->checkpoint_file + "'");
+	else if(P->verbose)
+		logger::info("checkpoint open " + std::to_string(open.size()) + " nodes " + std::to_string(nodes));
+
+	P->checkpoint_time = high_resolution_clock::now();
+
+	if(cancelled(P) || (P->stop_after > 0 && nodes >= P->stop_after))
+		P->stopped = true;
+}
+
+bool read_checkpoint(std::string path, Checkpoint &checkpoint, Problem *P){
+	char magic[sizeof(checkpoint_magic__)];
+	int32_t n, k, dim, solution_size;
+	int64_t nodes, ntasks, open_size;
+	uint64_t hash;
+
+	std::ifstream file(path, std::ifstream::binary);
+
+	if(!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), checkpoint_magic__))
+		return false;
+	if(!read__(file, n) || !read__(file, k) || !read__(file, dim) || !read__(file, hash))
+		return false;
+	if(n != P->n || k != P->k || dim != P->dim || hash != problem_hash(P))
+		return false;
+	if(!read__(file, checkpoint.best) || !read__(file, nodes) || !read__(file, ntasks) || !read__(file, solution_size))
+		return false;
+	if(solution_size != 0 && solution_size != P->k)
+		return false;
+
+	checkpoint.nodes = nodes;
+	checkpoint.ntasks = ntasks;
+	checkpoint.solution.resize(solution_size);
+
+	for(int &pos : checkpoint.solution)
+		if(!read__(file, pos) || pos < 0 || pos >= P->n)
+			return false;
+
+	if(!read__(file, open_size) || open_size < 0)
+		return false;
+
+	// the count is not trusted to size the list, a damaged count ends at the end of the file instead
+	for(int64_t i = 0; i < open_size; ++i){
+		Subproblem sp;
+
+		if(!read_subproblem(file, sp, P))
+			return false;
+
+		checkpoint.open.push_back(sp);
+	}
+
+	return true;
+}
@@ -0,0 +1,58 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "util.h"
+#include "hssp.h"
+
+#include <string>    // string
+#include <vector>    // vector
+#include <fstream>   // ifstream, ofstream
+#include <algorithm> // find, fill
+#include <numeric>   // accumulate
+#include <chrono>    // high_resolution_clock, now, duration
+#include <cstdio>    // rename
+#include <cstring>   // memcpy
+#include <cstdint>   // int32_t, int64_t, uint64_t
+
+using namespace std::chrono;
+
+struct Checkpoint {
+	double best;
+	std::vector<int> solution;
+	long int nodes, ntasks;
+	std::vector<Subproblem> open;
+};
+
+// the values of the files and of the messages are stored in little endian order on every host
+template <typename T> T little_endian__(T value){
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	char bytes[sizeof(T)];
+	std::memcpy(bytes, &value, sizeof(T));
+	std::reverse(bytes, bytes + sizeof(T));
+	std::memcpy(&value, bytes, sizeof(T));
+#endif
+	return value;
+}
+
+template <typename T> void write__(std::ostream &stream, const T &value){
+	const T stored = little_endian__(value);
+	stream.write((const char *) &stored, sizeof(T));
+}
+
+template <typename T> bool read__(std::istream &stream, T &value){
+	if(!stream.read((char *) &value, sizeof(T)))
+		return false;
+
+	value = little_endian__(value);
+	return true;
+}
+
+void write_subproblem(std::ostream & , const Subproblem & , Problem * );
+bool read_subproblem(std::istream & , Subproblem & , Problem * );
+bool checkpoint_due(Problem * );
+Subproblem task_subproblem(const Task & , Problem * );
+void start_path(const Subproblem & , int , Problem * );
+void save_checkpoint(std::vector<Task> & , Problem * );
+bool read_checkpoint(std::string , Checkpoint & , Problem * );
+
+#endif
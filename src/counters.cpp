@@ -0,0 +1,106 @@
+#include "counters.h"
+
+thread_local ThreadCounting *counting__ = nullptr;
+
+// type and configuration of each event for perf_event_open. the last level cache misses are those
+// of the generic cache miss event
+const std::pair<uint32_t, uint64_t> perf_events__[EVENTS] = {
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+// the first event that opens leads the group. an event that does not fit in the group with the
+// others is refused when it is opened, so every event of the group is counted at the same time
+CounterGroup::CounterGroup(bool open){
+	std::fill(fds, fds + EVENTS, -1);
+	std::fill(slots, slots + EVENTS, -1);
+
+	for(int e = 0; open && e < EVENTS; ++e){
+		perf_event_attr attr {};
+		attr.size = sizeof(attr);
+		attr.type = perf_events__[e].first;
+		attr.config = perf_events__[e].second;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		fds[e] = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+		if(fds[e] < 0)
+			continue;
+
+		if(leader < 0)
+			leader = fds[e];
+		slots[e] = size++;
+	}
+}
+
+CounterGroup::~CounterGroup(){
+	for(int e = EVENTS - 1; e >= 0; --e)
+		if(fds[e] >= 0)
+			close(fds[e]);
+}
+
+// values of the events since the group was opened, and zero for the events that are not counted.
+// the buffer has the number of events, the times the group was enabled and running, and the values.
+// when more groups want the counters than the cpu has, the kernel runs them in turns, so the values
+// are scaled by the time the group was enabled over the time it ran
+void CounterGroup::read(double *values){
+	uint64_t buffer[3 + EVENTS] = {};
+
+	if(size && ::read(leader, buffer, sizeof(buffer)) <= 0)
+		std::fill(buffer, buffer + 3 + EVENTS, 0);
+
+	const uint64_t enabled = buffer[1], running = buffer[2];
+	if(enabled > 0 && running == 0)
+		unscheduled = true;
+
+	const double scale = running > 0 ? (double) enabled / running : 0.0;
+	for(int e = 0; e < EVENTS; ++e)
+		values[e] = counts(e) ? buffer[3 + slots[e]] * scale : 0.0;
+}
+
+ThreadCounting::ThreadCounting(ThreadCounters *counters_) : counters(counters_), group(counters_ != nullptr) {
+	if(!counters)
+		return;
+
+	for(int e = 0; e < EVENTS; ++e)
+		counters->counted[e] = group.counts(e);
+
+	counting__ = this;
+}
+
+// the events of a group that never ran are not counted
+ThreadCounting::~ThreadCounting(){
+	if(!counters)
+		return;
+
+	for(int e = 0; e < EVENTS; ++e)
+		counters->counted[e] = counters->counted[e] && group.counts(e);
+
+	counting__ = nullptr;
+}
+
+inline double steady_ns(){
+	return duration<double, std::nano>(steady_clock::now().time_since_epoch()).count();
+}
+
+void ThreadCounting::begin(double &time, double *events){
+	group.read(events);
+	time = steady_ns();
+}
+
+void ThreadCounting::end(Kernel kernel, double time, const double *events){
+	const double now = steady_ns();
+	KernelCounters &counter = counters->kernels[kernel];
+	double values[EVENTS];
+
+	group.read(values);
+	counter.calls++;
+	counter.time += now - time;
+
+	for(int e = 0; e < EVENTS; ++e)
+		counter.events[e] += values[e] - events[e];
+}
@@ -0,0 +1,62 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include "util.h"
+
+#include <chrono>    // steady_clock, duration
+#include <algorithm> // fill
+#include <cstdint>   // uint64_t
+#include <unistd.h>  // syscall, read, close
+#include <sys/syscall.h>      // SYS_perf_event_open
+#include <linux/perf_event.h> // perf_event_attr, PERF_TYPE_*, PERF_COUNT_*, PERF_FORMAT_*
+
+using namespace std::chrono;
+
+// hardware events of the calling thread, opened as one group so that they are read at once. the
+// events the cpu or the kernel do not offer are left out, which may be all of them in a virtual
+// machine or with a restrictive perf_event_paranoid, and so are those of a group that never ran
+class CounterGroup {
+	int leader = -1, size = 0;
+	int fds[EVENTS], slots[EVENTS]; // descriptor of each event and its position in the group
+	bool unscheduled = false;       // the group was enabled but the kernel never ran it
+
+public:
+	CounterGroup(bool = true );
+	~CounterGroup();
+	bool counts(int event) const { return slots[event] >= 0 && !unscheduled; }
+	void read(double * );
+};
+
+// counts the kernels called by the calling thread into its counters while it lives. nothing is
+// counted without counters
+class ThreadCounting {
+	ThreadCounters *counters;
+	CounterGroup group;
+
+public:
+	ThreadCounting(ThreadCounters * );
+	~ThreadCounting();
+	void begin(double & , double * );
+	void end(Kernel , double , const double * );
+};
+
+extern thread_local ThreadCounting *counting__;
+
+// counts the time and the events from its creation to its destruction as a call of the kernel
+class CounterScope {
+	ThreadCounting *counting;
+	Kernel kernel;
+	double time = 0.0, events[EVENTS];
+
+public:
+	CounterScope(Kernel kernel_) : counting(counting__), kernel(kernel_) {
+		if(counting)
+			counting->begin(time, events);
+	}
+	~CounterScope(){
+		if(counting)
+			counting->end(kernel, time, events);
+	}
+};
+
+#endif
@@ -0,0 +1,333 @@
+#include "daemon.h"
+
+// a solve requested by a client. it is stopped at its deadline, when its client asks for it or hangs
+// up, and when the daemon is stopped
+struct Request {
+	Channel *ch;
+	CancelToken cancel;
+	high_resolution_clock::time_point deadline;
+	bool timed;
+};
+
+struct Daemon {
+	Problem *P;
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::list<Request *> requests; // requests that are solved or wait for a free solver
+	std::vector<Channel *> channels;
+	int free, connections = 0;
+};
+
+std::string encode_request(const std::vector<std::vector<double> > &points, const std::vector<double> &ref, const SolveOptions &options, double deadline){
+	std::ostringstream ss;
+	const int32_t dim = points.empty() ? ref.size() : points[0].size();
+	const int32_t flags = (options.maximize ? REQUEST_MAXIMIZE : 0) | (options.deterministic ? REQUEST_DETERMINISTIC : 0) | (options.portfolio ? REQUEST_PORTFOLIO : 0);
+
+	write__(ss, (int32_t) points.size());
+	write__(ss, dim);
+	write__(ss, (int32_t) options.k);
+	write__(ss, (int32_t) options.cores);
+	write__(ss, flags);
+	write__(ss, deadline);
+
+	// the reference point is the origin when it is not given
+	for(int d = 0; d < dim; ++d)
+		write__(ss, ref.empty() ? 0.0 : ref[d]);
+	for(const std::vector<double> &point : points)
+		for(double value : point)
+			write__(ss, value);
+
+	return ss.str();
+}
+
+bool decode_request(const std::string &payload, std::vector<std::vector<double> > &points, std::vector<double> &ref, SolveOptions &options, double &deadline){
+	std::istringstream ss(payload);
+	int32_t n, dim, k, cores, flags;
+
+	if(!read__(ss, n) || !read__(ss, dim) || !read__(ss, k) || !read__(ss, cores) || !read__(ss, flags) || !read__(ss, deadline))
+		return false;
+	if(n < 0 || dim <= 0 || payload.size() != 5 * sizeof(int32_t) + sizeof(double) * (1 + dim + (size_t) n * dim))
+		return false;
+
+	ref.resize(dim);
+	points.assign(n, std::vector<double>(dim));
+	for(double &value : ref)
+		read__(ss, value);
+	for(std::vector<double> &point : points)
+		for(double &value : point)
+			read__(ss, value);
+
+	options.k = k;
+	options.cores = cores;
+	options.maximize = flags & REQUEST_MAXIMIZE;
+	options.deterministic = flags & REQUEST_DETERMINISTIC;
+	options.portfolio = flags & REQUEST_PORTFOLIO;
+	return (bool) ss;
+}
+
+// a solution is sent as the positions of its points
+std::string encode_solution(bool optimal, double volume, int64_t nodes, double time, const std::vector<int> &solution){
+	std::ostringstream ss;
+
+	write__(ss, (int32_t) optimal);
+	write__(ss, volume);
+	write__(ss, nodes);
+	write__(ss, time);
+	write__(ss, (int32_t) std::count(solution.begin(), solution.end(), 1));
+
+	for(int i = 0; i < (int) solution.size(); ++i)
+		if(solution[i])
+			write__(ss, (int32_t) i);
+
+	return ss.str();
+}
+
+bool decode_solution(const std::string &payload, int n, bool &optimal, double &volume, long int &nodes, double &time, std::vector<int> &solution){
+	std::istringstream ss(payload);
+	int32_t flag, size, pos;
+	int64_t nodes64;
+
+	if(!read__(ss, flag) || !read__(ss, volume) || !read__(ss, nodes64) || !read__(ss, time) || !read__(ss, size) || size < 0 || size > n)
+		return false;
+
+	optimal = flag;
+	nodes = nodes64;
+	solution.assign(n, 0);
+
+	for(int i = 0; i < size; ++i){
+		if(!read__(ss, pos) || pos < 0 || pos >= n)
+			return false;
+
+		solution[pos] = 1;
+	}
+
+	return true;
+}
+
+// solves the requests of a client one after another. the new best solutions of a solve are streamed
+// to the client before its result
+void serve_client(Daemon &D, Channel *ch){
+	MessageType type;
+	std::string payload;
+
+	while(ch->receive(type, payload)){
+		std::vector<std::vector<double> > points;
+		std::vector<double> ref;
+		SolveOptions options;
+		Request request;
+		double deadline;
+
+		// a stop that arrives after its solve ended is of no use
+		if(type == MSG_STOP)
+			continue;
+
+		if(type != MSG_SOLVE || !decode_request(payload, points, ref, options, deadline)){
+			if(!ch->send(MSG_ERROR, "invalid request\n"))
+				break;
+
+			continue;
+		}
+
+		const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		request.ch = ch;
+		request.timed = deadline > 0;
+		request.deadline = t0 + duration_cast<high_resolution_clock::duration>(duration<double>(deadline));
+
+		// a request stopped while it waits for a free solver is still solved, which returns at once
+		std::unique_lock<std::mutex> lock(D.mtx);
+		D.requests.push_back(&request);
+		D.cv.wait(lock, [&D, &request]{ return D.free > 0 || request.cancel.cancelled(); });
+
+		const int solver = D.free > 0;
+		D.free -= solver;
+		lock.unlock();
+
+		options.cancel = &request.cancel;
+		options.progress = [ch, &request](const SolveProgress &progress){
+			if(progress.type != "init" && progress.type != "new")
+				return;
+			if(!ch->send(MSG_PROGRESS, encode_solution(false, progress.best, progress.nodes, progress.time, progress.solution)))
+				request.cancel.cancel();
+		};
+
+		const SolveResult result = solve(points, ref, options);
+		const duration<double> elapsed = high_resolution_clock::now() - t0;
+
+		lock.lock();
+		D.free += solver;
+		D.requests.remove(&request);
+		D.cv.notify_all();
+		lock.unlock();
+
+		if(D.P->verbose)
+			logger::info("request points " + std::to_string(points.size()) + " k " + std::to_string(options.k) + " nodes " + std::to_string(result.nodes) + " time " + std::to_string(elapsed.count()) + "s" + (result.optimal ? "" : " stopped"));
+
+		if(!result.error.empty() ? !ch->send(MSG_ERROR, result.error) : !ch->send(MSG_RESULT, encode_solution(result.optimal, result.volume, result.nodes, elapsed.count(), result.solution)))
+			break;
+	}
+
+	std::lock_guard<std::mutex> lg(D.mtx);
+	D.channels.erase(std::remove(D.channels.begin(), D.channels.end(), ch), D.channels.end());
+	D.connections--;
+	D.cv.notify_all();
+	delete ch;
+}
+
+// serves the clients that connect to the address until the daemon is cancelled. each client has its
+// own thread for the whole connection, and at most -j requests are solved at the same time
+void run_daemon(Problem *P){
+	Daemon D;
+	D.P = P;
+	D.free = P->cores;
+
+	const int listener = listen_at(P->daemon_address);
+
+	if(listener < 0){
+		logger::fail("failed to listen at '" + P->daemon_address + "'");
+		return;
+	}
+
+	std::thread acceptor([&D, listener]{
+		int fd;
+
+		while((fd = accept(listener, nullptr, nullptr)) >= 0){
+			std::lock_guard<std::mutex> lg(D.mtx);
+			D.channels.push_back(new Channel(fd));
+			D.connections++;
+			std::thread(serve_client, std::ref(D), D.channels.back()).detach();
+		}
+	});
+
+	// stops the requests whose deadline passed and those whose client sent a message or hung up, since
+	// a client only sends a stop while its request is solved
+	std::unique_lock<std::mutex> lock(D.mtx);
+	while(!cancelled(P)){
+		D.cv.wait_for(lock, milliseconds(10));
+		const high_resolution_clock::time_point now = high_resolution_clock::now();
+
+		for(Request *request : D.requests){
+			if(!request->cancel.cancelled() && ((request->timed && now >= request->deadline) || request->ch->readable(0))){
+				request->cancel.cancel();
+				D.cv.notify_all();
+			}
+		}
+	}
+	lock.unlock();
+
+	// stops accepting new clients
+	shutdown(listener, SHUT_RDWR);
+	close(listener);
+	acceptor.join();
+
+	// the requests being solved are stopped and still send their result, and the clients that wait for
+	// a request end
+	lock.lock();
+	for(Request *request : D.requests)
+		request->cancel.cancel();
+	for(Channel *ch : D.channels)
+		ch->stop_receiving();
+
+	D.cv.notify_all();
+	D.cv.wait(lock, [&D]{ return D.connections == 0; });
+	lock.unlock();
+
+	sockaddr_un addr;
+	if(unix_address(P->daemon_address, addr))
+		unlink(addr.sun_path);
+}
+
+// solves the points on the daemon at the other end of the channel, as solve() does in this process.
+// the progress callback is called for the new best solutions streamed by the daemon. a cancel asks
+// the daemon to stop the solve, whose result is still returned
+SolveResult request_solve(Channel *ch, const std::vector<std::vector<double> > &points, const std::vector<double> &ref, const SolveOptions &options, double deadline){
+	SolveResult result {-1, {}, 0, false, "", {}};
+	bool stopping = false;
+
+	for(const std::vector<double> &point : points){
+		if(point.size() != points[0].size() || (!ref.empty() && point.size() != ref.size())){
+			result.error = "invalid input data point or reference point dimension\n";
+			return result;
+		}
+	}
+
+	if(!ch->send(MSG_SOLVE, encode_request(points, ref, options, deadline))){
+		result.error = "lost connection to the daemon\n";
+		return result;
+	}
+
+	while(true){
+		MessageType type;
+		std::string payload;
+		SolveProgress progress {"new", 0.0, 0, 0.0, {}};
+		bool optimal;
+
+		if(!stopping && options.cancel && options.cancel->cancelled())
+			stopping = ch->send(MSG_STOP);
+		if(!ch->readable(100))
+			continue;
+
+		if(!ch->receive(type, payload)){
+			result.error = "lost connection to the daemon\n";
+			return result;
+		}
+		else if(type == MSG_PROGRESS && options.progress){
+			if(decode_solution(payload, points.size(), optimal, progress.best, progress.nodes, progress.time, progress.solution))
+				options.progress(progress);
+		}
+		else if(type == MSG_RESULT){
+			double time;
+
+			if(!decode_solution(payload, points.size(), result.optimal, result.volume, result.nodes, time, result.solution))
+				result.error = "invalid result received from the daemon\n";
+
+			return result;
+		}
+		else if(type == MSG_ERROR){
+			result.error = payload;
+			return result;
+		}
+	}
+}
+
+// solves the points read by the command line on the daemon at the address of the client option
+double run_client(Problem *P, std::vector<int> &sol, long int &nodes){
+	std::vector<std::vector<double> > points(P->n);
+	SolveOptions options;
+	Channel *ch = connect_to(P->client_address, 10.0);
+
+	if(!ch){
+		ERROR(P, "failed to connect to the daemon at '" + P->client_address + "'\n");
+		return -1;
+	}
+
+	// the points are sent normalized, so the reference point is the origin of a minimization problem
+	for(int i = 0; i < P->n; ++i)
+		points[i].assign(P->X[i].values, P->X[i].values + P->dim);
+
+	options.k = P->k;
+	options.cores = P->cores;
+	options.deterministic = P->deterministic;
+	options.portfolio = !P->portfolio.empty();
+	options.cancel = P->cancel;
+	options.progress = [P](const SolveProgress &progress){
+		if(!P->verbose)
+			return;
+
+		std::stringstream ss;
+		ss << "lbound " << std::fixed << std::setprecision(PRECISION) << progress.best << " nodes " << progress.nodes << " time " << std::setprecision(6) << progress.time << "s type daemon";
+		logger::info(ss.str());
+	};
+
+	const SolveResult result = request_solve(ch, points, std::vector<double>(P->dim, 0.0), options, P->deadline);
+	delete ch;
+
+	if(!result.error.empty()){
+		ERROR(P, result.error);
+		return -1;
+	}
+
+	sol = result.solution;
+	nodes = result.nodes;
+	P->stopped = !result.optimal;
+	return result.volume;
+}
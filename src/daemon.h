@@ -0,0 +1,30 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include "util.h"
+#include "solver.h"
+#include "distributed.h"
+
+#include <string>             // string
+#include <vector>             // vector
+#include <list>               // list
+#include <sstream>            // ostringstream, istringstream
+#include <mutex>              // mutex, unique_lock, lock_guard
+#include <condition_variable> // condition_variable
+#include <thread>             // thread
+#include <chrono>             // high_resolution_clock, duration, milliseconds
+#include <algorithm>          // count, remove
+#include <iomanip>            // setprecision
+#include <cstdint>            // int32_t, int64_t
+#include <sys/socket.h>       // accept, shutdown
+
+using namespace std::chrono;
+
+// bits of the flags of a request
+enum RequestFlags : int32_t { REQUEST_MAXIMIZE = 1, REQUEST_DETERMINISTIC = 2, REQUEST_PORTFOLIO = 4 };
+
+void run_daemon(Problem * );
+SolveResult request_solve(Channel * , const std::vector<std::vector<double> > & , const std::vector<double> & , const SolveOptions & , double );
+double run_client(Problem * , std::vector<int> & , long int & );
+
+#endif
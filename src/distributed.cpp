@@ -0,0 +1,499 @@
+#include "distributed.h"
+
+// a peer that hung up fails the send instead of raising SIGPIPE, which would end the process
+bool write_all(int fd, const char *data, size_t size){
+	while(size > 0){
+		const ssize_t w = ::send(fd, data, size, MSG_NOSIGNAL);
+
+		if(w < 0 && errno == EINTR)
+			continue;
+		if(w <= 0)
+			return false;
+
+		data += w;
+		size -= w;
+	}
+
+	return true;
+}
+
+bool read_all(int fd, char *data, size_t size){
+	while(size > 0){
+		const ssize_t r = read(fd, data, size);
+
+		if(r < 0 && errno == EINTR)
+			continue;
+		if(r <= 0)
+			return false;
+
+		data += r;
+		size -= r;
+	}
+
+	return true;
+}
+
+Channel::Channel(int fd_) : fd(fd_) {}
+
+Channel::~Channel(){
+	close(fd);
+}
+
+// ends the connection in both directions. a thread blocked receiving from the channel returns
+void Channel::hangup(){
+	shutdown(fd, SHUT_RDWR);
+}
+
+bool Channel::send(MessageType type, const std::string &payload){
+	std::lock_guard<std::mutex> lg(send_mtx);
+	const int32_t t = little_endian__((int32_t) type);
+	const int64_t size = little_endian__((int64_t) payload.size());
+
+	char header[sizeof(t) + sizeof(size)];
+	std::memcpy(header, &t, sizeof(t));
+	std::memcpy(header + sizeof(t), &size, sizeof(size));
+
+	return write_all(fd, header, sizeof(header)) && write_all(fd, payload.data(), payload.size());
+}
+
+bool Channel::receive(MessageType &type, std::string &payload){
+	int32_t t;
+	int64_t size;
+
+	if(!read_all(fd, (char *) &t, sizeof(t)) || !read_all(fd, (char *) &size, sizeof(size)))
+		return false;
+
+	size = little_endian__(size);
+
+	if(size < 0 || size > max_message_size__)
+		return false;
+
+	payload.resize(size);
+
+	if(!read_all(fd, &payload[0], size))
+		return false;
+
+	type = (MessageType) little_endian__(t);
+	return true;
+}
+
+// ends the connection in the receiving direction only. a thread blocked receiving returns, but the
+// messages that are still sent arrive
+void Channel::stop_receiving(){
+	shutdown(fd, SHUT_RD);
+}
+
+// waits up to the given milliseconds for a message or for the end of the stream
+bool Channel::readable(int timeout){
+	pollfd pfd {fd, POLLIN, 0};
+	return poll(&pfd, 1, timeout) > 0;
+}
+
+// only Unix sockets are supported for now. the address is a path, optionally prefixed by "unix:"
+bool unix_address(std::string address, sockaddr_un &addr){
+	if(address.compare(0, 5, "unix:") == 0)
+		address = address.substr(5);
+	if(address.empty() || address.size() >= sizeof(addr.sun_path))
+		return false;
+
+	addr = sockaddr_un {};
+	addr.sun_family = AF_UNIX;
+	std::strncpy(addr.sun_path, address.c_str(), sizeof(addr.sun_path) - 1);
+	return true;
+}
+
+int listen_at(std::string address){
+	sockaddr_un addr;
+
+	if(!unix_address(address, addr))
+		return -1;
+
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(addr.sun_path);
+
+	if(fd < 0)
+		return -1;
+	if(bind(fd, (sockaddr *) &addr, sizeof(addr)) || listen(fd, 64)){
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+// the coordinator may not be listening yet, so the connection is retried until the timeout
+Channel *connect_to(std::string address, double timeout){
+	sockaddr_un addr;
+	const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
+	if(!unix_address(address, addr))
+		return nullptr;
+
+	while(true){
+		const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+		if(fd < 0)
+			return nullptr;
+		if(!connect(fd, (sockaddr *) &addr, sizeof(addr)))
+			return new Channel(fd);
+
+		close(fd);
+
+		const duration<double> elapsed = high_resolution_clock::now() - t0;
+		if(elapsed.count() >= timeout)
+			return nullptr;
+
+		std::this_thread::sleep_for(milliseconds(50));
+	}
+}
+
+std::string encode_problem(Problem *P){
+	std::ostringstream ss;
+
+	write__(ss, (int32_t) P->n);
+	write__(ss, (int32_t) P->k);
+	write__(ss, (int32_t) P->dim);
+	for(int i = 0; i < P->n * P->dim; ++i)
+		write__(ss, P->X->values[i]);
+	for(int d = 0; d < P->dim; ++d)
+		write__(ss, P->ref[d]);
+
+	return ss.str();
+}
+
+bool decode_problem(const std::string &payload, Problem *P){
+	std::istringstream ss(payload);
+	int32_t n, k, dim;
+
+	if(!read__(ss, n) || !read__(ss, k) || !read__(ss, dim) || n <= 0 || dim <= 0 || k < 0 || k > n)
+		return false;
+
+	P->n = n;
+	P->k = k;
+	P->dim = dim;
+	P->ref = new double[P->dim]();
+	P->X = new_points(P->n, P->dim, true);
+	P->solution = new_points(P->n, P->dim, false);
+	P->initialized = true;
+
+	for(int i = 0; i < P->n * P->dim; ++i)
+		if(!read__(ss, P->X->values[i]))
+			return false;
+	for(int d = 0; d < P->dim; ++d)
+		if(!read__(ss, P->ref[d]))
+			return false;
+
+	return true;
+}
+
+std::string encode_incumbent(Problem *P){
+	std::ostringstream ss;
+
+	write__(ss, P->best);
+	for(Point *p = P->solution; p != P->solution + P->k; ++p)
+		write__(ss, (int32_t) point_index(p, P));
+
+	return ss.str();
+}
+
+bool decode_incumbent(const std::string &payload, double &best, std::vector<int> &solution, Problem *P){
+	std::istringstream ss(payload);
+	solution.resize(P->k);
+
+	if(!read__(ss, best))
+		return false;
+
+	for(int &pos : solution)
+		if(!read__(ss, pos) || pos < 0 || pos >= P->n)
+			return false;
+
+	return true;
+}
+
+// splits the top of the search tree in at least the given number of parts by deciding the points of
+// largest root hypervolume contribution. the subproblems that accept these points come first, as in
+// the sequential search
+std::vector<Subproblem> split_search(double *C, int parts, Problem *P){
+	std::vector<Subproblem> open;
+	std::vector<int> order(P->n);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [C](int a, int b) -> bool { return C[a] > C[b]; });
+
+	int depth = 0;
+	while(depth < P->n && depth < 20 && (1 << depth) < parts)
+		depth++;
+
+	const std::vector<int> rest(order.begin() + depth, order.end());
+
+	for(int mask = (1 << depth) - 1; mask >= 0; --mask){
+		Subproblem sp {{}, rest};
+
+		for(int d = 0; d < depth; ++d)
+			if(mask & (1 << (depth - 1 - d)))
+				sp.accepted.push_back(order[d]);
+
+		if((int) sp.accepted.size() <= P->k && (int) (sp.accepted.size() + rest.size()) >= P->k)
+			open.push_back(sp);
+	}
+
+	return open;
+}
+
+struct Coordinator {
+	Problem *P;
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<Subproblem> open;
+	std::vector<Channel *> channels;
+	int searching = 0;
+	bool finished = false;
+};
+
+// keeps the best of the solutions found by the workers and forwards it to the other workers
+void accept_incumbent(Coordinator &C, Channel *from, const std::string &payload){
+	Problem *P = C.P;
+	double best;
+	std::vector<int> solution;
+
+	if(!decode_incumbent(payload, best, solution, P))
+		return;
+
+	std::unique_lock<std::mutex> sl(P->solution_mtx);
+
+	if(best <= P->best)
+		return;
+
+	count(P->stats[0].incumbents);
+	P->best = best;
+	for(int i = 0; i < P->k; ++i)
+		P->solution[i] = P->X[solution[i]];
+
+	search_info("new", P, 0);
+	sl.unlock();
+
+	std::lock_guard<std::mutex> lg(C.mtx);
+	for(Channel *ch : C.channels)
+		if(ch != from)
+			ch->send(MSG_INCUMBENT, payload);
+}
+
+void serve(Coordinator &C, Channel *ch){
+	Problem *P = C.P;
+	bool lost = !ch->send(MSG_PROBLEM, encode_problem(P));
+
+	while(!lost){
+		Subproblem sp;
+		std::unique_lock<std::mutex> ul(C.mtx);
+		C.cv.wait(ul, [&C]{ return !C.open.empty() || C.finished; });
+
+		if(C.finished)
+			break;
+
+		sp = C.open.front();
+		C.open.pop_front();
+		C.searching++;
+		ul.unlock();
+
+		std::unique_lock<std::mutex> sl(P->solution_mtx);
+		const double best = P->best;
+		sl.unlock();
+
+		std::ostringstream task;
+		write__(task, best);
+		write_subproblem(task, sp, P);
+		lost = !ch->send(MSG_TASK, task.str());
+
+		// handle the messages of the worker until it finishes the subproblem
+		while(!lost){
+			MessageType type;
+			std::string payload;
+			int64_t nodes;
+
+			if(!ch->receive(type, payload)){
+				lost = true;
+			}
+			else if(type == MSG_INCUMBENT){
+				accept_incumbent(C, ch, payload);
+			}
+			else if(type == MSG_DONE){
+				std::istringstream ss(payload);
+
+				if(read__(ss, nodes)){
+					std::lock_guard<std::mutex> lg(P->solution_mtx);
+					count(P->stats[0].nodes, nodes);
+					count(P->stats[0].tasks);
+				}
+
+				break;
+			}
+		}
+
+		ul.lock();
+		C.searching--;
+
+		// the subproblem of a lost worker is given to the next one
+		if(lost)
+			C.open.push_front(sp);
+		if(C.open.empty() && C.searching == 0)
+			C.finished = true;
+
+		C.cv.notify_all();
+		ul.unlock();
+	}
+
+	if(!lost)
+		ch->send(MSG_STOP);
+	else if(!P->stopped)
+		logger::warn("lost connection to a worker");
+
+	std::lock_guard<std::mutex> lg(C.mtx);
+	C.channels.erase(std::remove(C.channels.begin(), C.channels.end(), ch), C.channels.end());
+	delete ch;
+}
+
+void serve_workers(std::vector<Subproblem> open, Problem *P){
+	Coordinator C;
+	C.P = P;
+	C.open.assign(open.begin(), open.end());
+	C.finished = C.open.empty();
+
+	const int listener = listen_at(P->serve_address);
+	std::vector<std::thread> handlers;
+
+	if(listener < 0){
+		logger::fail("failed to listen at '" + P->serve_address + "'");
+		return;
+	}
+
+	std::thread acceptor([&C, &handlers, listener]{
+		int fd;
+
+		while((fd = accept(listener, nullptr, nullptr)) >= 0){
+			std::lock_guard<std::mutex> lg(C.mtx);
+			C.channels.push_back(new Channel(fd));
+			handlers.push_back(std::thread(serve, std::ref(C), C.channels.back()));
+		}
+	});
+
+	// a cancelled search stops waiting for the workers. hanging up ends the handlers of the workers
+	// that are still searching
+	std::unique_lock<std::mutex> ul(C.mtx);
+	while(!C.cv.wait_for(ul, std::chrono::milliseconds(100), [&C]{ return C.finished; })){
+		if(cancelled(P)){
+			P->stopped = true;
+			C.finished = true;
+			for(Channel *ch : C.channels)
+				ch->hangup();
+			C.cv.notify_all();
+		}
+	}
+	ul.unlock();
+
+	// stops accepting new workers
+	shutdown(listener, SHUT_RDWR);
+	close(listener);
+	acceptor.join();
+
+	for(std::thread &t : handlers)
+		t.join();
+
+	sockaddr_un addr;
+	if(unix_address(P->serve_address, addr))
+		unlink(addr.sun_path);
+}
+
+void run_worker(Problem *P){
+	MessageType type;
+	std::string payload;
+	Channel *ch = connect_to(P->worker_address, 10.0);
+
+	if(!ch){
+		logger::fail("failed to connect to '" + P->worker_address + "'");
+		return;
+	}
+	if(!ch->receive(type, payload) || type != MSG_PROBLEM || !decode_problem(payload, P)){
+		logger::fail("invalid problem received from the coordinator");
+		delete ch;
+		return;
+	}
+
+	P->best = -INF;
+	P->stats = new ThreadStats[P->cores]();
+	P->task_sizes.resize(64);
+	P->new_best = [ch](Problem *problem){ ch->send(MSG_INCUMBENT, encode_incumbent(problem)); };
+
+	double C[P->n], Cr[P->n];
+	root_contributions(C, Cr, P);
+
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<std::pair<double, Subproblem> > tasks;
+	bool stop = false;
+
+	// receives the subproblems and the solutions found by the other workers during the search
+	std::thread reader([&]{
+		bool lost = true;
+
+		while(ch->receive(type, payload)){
+			std::istringstream ss(payload);
+			std::pair<double, Subproblem> task;
+
+			if(type == MSG_TASK && read__(ss, task.first) && read_subproblem(ss, task.second, P)){
+				std::lock_guard<std::mutex> lg(mtx);
+				tasks.push_back(task);
+				cv.notify_one();
+			}
+			else if(type == MSG_INCUMBENT && read__(ss, task.first)){
+				std::lock_guard<std::mutex> lg(P->solution_mtx);
+				P->best = std::max(P->best, task.first);
+			}
+			else if(type == MSG_STOP){
+				lost = false;
+				break;
+			}
+		}
+
+		// without the coordinator the current subproblem is of no use
+		if(lost)
+			P->stopped = true;
+
+		std::lock_guard<std::mutex> lg(mtx);
+		stop = true;
+		cv.notify_one();
+	});
+
+	while(true){
+		std::unique_lock<std::mutex> ul(mtx);
+		cv.wait(ul, [&]{ return !tasks.empty() || stop; });
+
+		if(tasks.empty())
+			break;
+
+		const std::pair<double, Subproblem> task = tasks.front();
+		tasks.pop_front();
+		ul.unlock();
+
+		std::unique_lock<std::mutex> sl(P->solution_mtx);
+		P->best = std::max(P->best, task.first);
+		sl.unlock();
+
+		const long int before = total(P, &ThreadStats::nodes);
+		search_subproblems({task.second}, Cr, P);
+		const long int after = total(P, &ThreadStats::nodes);
+
+		// a subproblem that was not fully searched is left to the coordinator to hand out again
+		if(P->stopped)
+			break;
+
+		std::ostringstream done;
+		write__(done, (int64_t) (after - before));
+
+		if(!ch->send(MSG_DONE, done.str()))
+			break;
+	}
+
+	ch->hangup();
+	reader.join();
+	P->new_best = nullptr;
+	delete ch;
+}
@@ -0,0 +1,64 @@
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include "util.h"
+#include "hssp.h"
+#include "checkpoint.h"
+
+#include <string>             // string
+#include <vector>             // vector
+#include <deque>              // deque
+#include <sstream>            // ostringstream, istringstream
+#include <mutex>              // mutex, unique_lock, lock_guard
+#include <condition_variable> // condition_variable
+#include <thread>             // thread, sleep_for
+#include <numeric>            // iota, accumulate
+#include <algorithm>          // stable_sort, remove
+#include <chrono>             // high_resolution_clock, milliseconds
+#include <cstdint>            // int32_t, int64_t
+#include <cstring>            // memcpy, strncpy
+#include <cerrno>             // errno, EINTR
+#include <unistd.h>           // read, close, unlink
+#include <sys/socket.h>       // socket, bind, listen, accept, connect, send, shutdown, MSG_NOSIGNAL
+#include <sys/un.h>           // sockaddr_un
+#include <poll.h>             // poll
+
+enum MessageType : int32_t {
+	MSG_PROBLEM,   // coordinator to worker: the normalized points of the problem
+	MSG_TASK,      // coordinator to worker: a subproblem and the best hypervolume so far
+	MSG_INCUMBENT, // both ways: a new best solution
+	MSG_DONE,      // worker to coordinator: the subproblem was searched
+	MSG_STOP,      // coordinator to worker: there are no more subproblems. client to daemon: stop the solve
+	MSG_SOLVE,     // client to daemon: the points, the reference point and the options of a solve
+	MSG_PROGRESS,  // daemon to client: a new best solution of the solve
+	MSG_RESULT,    // daemon to client: the final solution of the solve
+	MSG_ERROR      // daemon to client: the request was rejected
+};
+
+// the largest payload that is received. a larger size in a header is taken as a broken stream
+const int64_t max_message_size__ = (int64_t) 1 << 30;
+
+// framed messages over a reliable ordered byte stream. the protocol does not depend on the
+// transport, only opening the stream does. the values are sent in little endian order
+class Channel {
+	int fd;
+	std::mutex send_mtx;
+
+public:
+	Channel(int );
+	~Channel();
+	bool send(MessageType , const std::string & = "" );
+	bool receive(MessageType & , std::string & );
+	bool readable(int );
+	void hangup();
+	void stop_receiving();
+};
+
+bool unix_address(std::string , sockaddr_un & );
+int listen_at(std::string );
+Channel *connect_to(std::string , double );
+std::vector<Subproblem> split_search(double * , int , Problem * );
+void serve_workers(std::vector<Subproblem> , Problem * );
+void run_worker(Problem * );
+
+#endif
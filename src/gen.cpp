@@ -0,0 +1,67 @@
+#include "util.h"
+#include "generator.h"
+
+#include <string>    // string
+#include <vector>    // vector
+#include <iostream>  // cout, cerr
+#include <fstream>   // ofstream
+
+void gen_usage(){
+	std::cerr << "usage: hssp-gen [--front linear|concave|convex|cliff|random] [-n N] [-d D] [--seed S] [--sets M] [-o FILE]" << std::endl;
+}
+
+// writes seeded fronts as input files. the sets of a file given to '--batch' are generated with the
+// seeds that follow the first one
+int main(int argc, char **argv){
+	std::vector<std::string> args(argv+1, argv+argc);
+	FrontFamily family = FRONT_CONCAVE;
+	std::string output;
+	int n = 100, dim = 3, seed = 1, sets = 1;
+
+	for(std::vector<std::string>::iterator it = args.begin(); it != args.end(); ++it){
+		const bool last = std::next(it) == args.end();
+		bool invalid = last;
+
+		if(*it == "--front" && !last)
+			invalid = !front_family(*++it, family);
+		else if(*it == "-n" && !last)
+			invalid = stoi__(&n, *++it);
+		else if(*it == "-d" && !last)
+			invalid = stoi__(&dim, *++it);
+		else if(*it == "--seed" && !last)
+			invalid = stoi__(&seed, *++it);
+		else if(*it == "--sets" && !last)
+			invalid = stoi__(&sets, *++it) || sets < 1;
+		else if(*it == "-o" && !last)
+			output = *++it;
+		else
+			invalid = true;
+
+		if(invalid){
+			gen_usage();
+			return 1;
+		}
+	}
+
+	if(n < 1 || dim < 2 || (family == FRONT_CLIFF && dim < 3)){
+		logger::fail("fronts need n >= 1 and d >= 2, and cliff fronts d >= 3");
+		return 1;
+	}
+
+	std::ofstream file;
+	if(!output.empty())
+		file.open(output, std::ofstream::trunc);
+
+	std::ostream &stream = output.empty() ? std::cout : file;
+
+	for(int s = 0; s < sets; ++s)
+		write_front(stream, generate_front(family, n, dim, seed + s));
+
+	stream.flush();
+	if(!stream.good()){
+		logger::fail("failed to write '" + output + "'");
+		return 1;
+	}
+
+	return 0;
+}
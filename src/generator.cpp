@@ -0,0 +1,106 @@
+#include "generator.h"
+
+const char *front_names__[] = {"linear", "concave", "convex", "cliff", "random"};
+
+bool front_family(const std::string &name, FrontFamily &family){
+	for(int f = FRONT_LINEAR; f <= FRONT_RANDOM; ++f){
+		if(name == front_names__[f]){
+			family = (FrontFamily) f;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// point drawn uniformly from the unit sphere of the positive orthant in the first dim coordinates
+void sphere_point(std::vector<double> &x, int dim, std::mt19937 &rng){
+	std::normal_distribution<double> normal;
+	double norm = 0.0;
+
+	while(norm == 0.0){
+		for(int d = 0; d < dim; ++d){
+			x[d] = std::fabs(normal(rng));
+			norm += x[d] * x[d];
+		}
+	}
+
+	norm = std::sqrt(norm);
+	for(int d = 0; d < dim; ++d)
+		x[d] /= norm;
+}
+
+// point drawn uniformly from the unit simplex
+void simplex_point(std::vector<double> &x, int dim, std::mt19937 &rng){
+	std::exponential_distribution<double> exponential;
+	double sum = 0.0;
+
+	while(sum == 0.0){
+		for(int d = 0; d < dim; ++d){
+			x[d] = exponential(rng);
+			sum += x[d];
+		}
+	}
+
+	for(int d = 0; d < dim; ++d)
+		x[d] /= sum;
+}
+
+// generates a front of n points in dim dimensions. the same seed always gives the same front. the
+// linear, concave and convex fronts lie on the simplex, the sphere and the reflected sphere, and a
+// cliff front has its first coordinates on the sphere and a uniform last one, so it needs d >= 3. a
+// random front bends each objective of a simplex front by its own exponent, which keeps the points
+// nondominated since the map of each objective is increasing. an empty set is returned for sizes
+// that can not be generated
+std::vector<std::vector<double> > generate_front(FrontFamily family, int n, int dim, unsigned int seed){
+	if(n < 0 || dim < 2 || (family == FRONT_CLIFF && dim < 3))
+		return {};
+
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> uniform;
+	std::vector<std::vector<double> > points(n, std::vector<double>(dim));
+	std::vector<double> exponents(dim);
+
+	// exponents between 1/4 and 4, which bend an objective convex or concave equally often
+	for(double &e : exponents)
+		e = std::exp(std::log(4.0) * (2.0 * uniform(rng) - 1.0));
+
+	for(std::vector<double> &x : points){
+		switch(family){
+			case FRONT_LINEAR:
+				simplex_point(x, dim, rng);
+				break;
+			case FRONT_CONCAVE:
+				sphere_point(x, dim, rng);
+				break;
+			case FRONT_CONVEX:
+				sphere_point(x, dim, rng);
+				for(double &v : x)
+					v = 1.0 - v;
+				break;
+			case FRONT_CLIFF:
+				sphere_point(x, dim - 1, rng);
+				x[dim - 1] = uniform(rng);
+				break;
+			case FRONT_RANDOM:
+				simplex_point(x, dim, rng);
+				for(int d = 0; d < dim; ++d)
+					x[d] = std::pow(x[d], exponents[d]);
+				break;
+		}
+	}
+
+	return points;
+}
+
+// writes the points as the validation files are written, one point per line after a comment line
+void write_front(std::ostream &stream, const std::vector<std::vector<double> > &points){
+	stream << "#\n" << std::fixed << std::setprecision(14);
+
+	for(const std::vector<double> &x : points){
+		for(double v : x)
+			stream << v << " ";
+
+		stream << "\n";
+	}
+}
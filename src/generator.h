@@ -0,0 +1,20 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <string>    // string
+#include <vector>    // vector
+#include <random>    // mt19937, normal_distribution, uniform_real_distribution, exponential_distribution
+#include <cmath>     // sqrt, fabs, pow, log, exp
+#include <ostream>   // ostream
+#include <iomanip>   // setprecision
+
+// families of the fronts of the validation files, extended to any dimension, and fronts of random
+// shape. every front is a set of mutually nondominated points of a minimization problem in the unit
+// cube, so the reference point "1 ... 1" dominates them
+enum FrontFamily { FRONT_LINEAR, FRONT_CONCAVE, FRONT_CONVEX, FRONT_CLIFF, FRONT_RANDOM };
+
+bool front_family(const std::string & , FrontFamily & );
+std::vector<std::vector<double> > generate_front(FrontFamily , int , int , unsigned int );
+void write_front(std::ostream & , const std::vector<std::vector<double> > & );
+
+#endif
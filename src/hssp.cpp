@@ -1,7 +1,20 @@
 #include "hssp.h"
-
-Pool::Pool(Problem *P_) : stop(false) {
+#include "checkpoint.h"
+#include "distributed.h"
+#include "parser.h"
+#include "daemon.h"
+#include "trace.h"
+#include "counters.h"
+#include "warm.h"
+
+Pool::Pool(Problem *P_) : waiting(0), queued(0), stop(false), pausing(false) {
 	this->P = P_;
+	placement = place_workers(P->affinity, P->cores);
+
+	if(!placement.empty())
+		P->numa_nodes.resize(P->cores);
+	for(int t = 0; t < (int) placement.size(); ++t)
+		P->numa_nodes[t] = placement[t].node;
 
 	for(int t = 0; t < P->cores; ++t)
 		threads.push_back(std::thread(&Pool::work, this, t));
@@ -22,7 +35,52 @@ int Pool::working(){
 	return workers;
 }
 
+// more workers wait for a task than there are tasks in the queue
+bool Pool::hungry(){
+	return waiting > queued;
+}
+
+bool Pool::saving(){
+	return pausing;
+}
+
+// stops all workers at a safe point to save the open subproblems of the search. the first worker
+// that arrives writes the checkpoint once the others are waiting for it
+void Pool::save(){
+	std::unique_lock<std::mutex> ul(tasks_mtx, std::defer_lock);
+	traced_lock(ul, P->trace);
+
+	if(pausing){
+		paused++;
+		pause_cv.notify_all();
+		pause_cv.wait(ul, [this]{ return !pausing; });
+		paused--;
+		return;
+	}
+
+	if(P->stopped || !checkpoint_due(P))
+		return;
+
+	pausing = true;
+	pause_cv.wait(ul, [this]{ return paused == workers - 1; });
+
+	std::vector<Task> open;
+	std::priority_queue<Task> copy = tasks;
+
+	for(; !copy.empty(); copy.pop())
+		open.push_back(copy.top());
+
+	save_checkpoint(open, P);
+	pausing = false;
+	pause_cv.notify_all();
+}
+
 Task Pool::snapshot(Point *S, Point *subset, double *C, double *Ce, double *Cr, double hv, double ubound1, int cur_pos, int subset_size, bool is_new){
+	return node_task(S, subset, C, Ce, Cr, hv, ubound1, cur_pos, subset_size, is_new, P);
+}
+
+// task of a node of the search, which copies the state the node has not decided yet
+Task node_task(Point *S, Point *subset, double *C, double *Ce, double *Cr, double hv, double ubound1, int cur_pos, int subset_size, bool is_new, Problem *P){
 	Task task {
 		new Point[P->n], new Point[P->k],
 		new double[P->n], new double[P->n], new double[P->n], hv, ubound1,
@@ -42,22 +100,74 @@ Task Pool::snapshot(Point *S, Point *subset, double *C, double *Ce, double *Cr,
 }
 
 void Pool::schedule(Point *S, Point *subset, double *C, double *Ce, double *Cr, double hv, double ubound1, int cur_pos, int subset_size, bool is_new){
+	TraceScope scope(P->trace, "schedule", "position");
+	scope.value = cur_pos;
+
 	const Task task = snapshot(S, subset, C, Ce, Cr, hv, ubound1, cur_pos, subset_size, is_new);
 
-	std::unique_lock<std::mutex> ul(tasks_mtx);
+	std::unique_lock<std::mutex> ul(tasks_mtx, std::defer_lock);
+	traced_lock(ul, P->trace);
 	tasks.push(task);
+	queued++;
 	cv.notify_one();
 	ul.unlock();
 }
 
+void Pool::schedule(std::vector<Task> &batch){
+	TraceScope scope(P->trace, "schedule", "tasks");
+	scope.value = batch.size();
+
+	std::unique_lock<std::mutex> ul(tasks_mtx, std::defer_lock);
+	traced_lock(ul, P->trace);
+
+	for(const Task &task : batch)
+		tasks.push(task);
+
+	queued += batch.size();
+	cv.notify_all();
+	ul.unlock();
+}
+
+void release(Task &task){
+	delete [] task.S; delete [] task.subset;
+	delete [] task.C; delete [] task.Ce; delete [] task.Cr;
+}
+
+void explore(Task &task, Point *aux1, double *aux2, int id, Pool *pool, Problem *P){
+	hvc_s *hvcs, *full;
+
+	{
+		TraceScope scope(P->trace, "build");
+		hvcs = build(task.S, task.subset, aux1, task.subset_size, 0, P->n, P->dim, P->ref, false);
+		full = build(task.S+task.cur_pos, task.subset, aux1, task.subset_size, P->n - task.cur_pos, P->n, P->dim, P->ref, true);
+	}
+
+	branch(task.S+task.cur_pos, task.subset+task.subset_size, task.subset, aux1, task.S, task.C, task.Ce, task.Cr, aux2, task.is_new, task.hv, task.ubound1, id, pool, hvcs, full, P);
+
+	if(P->dim == 3){
+		dealloc(hvcs);
+		dealloc(full);
+	}
+}
+
 void Pool::work(int id){
+	// pin the worker before its scratch buffers are first touched so they are placed on its node
+	const bool pinned = !placement.empty() && pin_thread(placement[id]);
 	bool dismiss = true;
 	Point aux1[P->n];
 	double aux2[P->n];
+	ThreadCounting counting(P->counting ? &P->counters[id] : nullptr);
+
+	if(P->trace)
+		P->trace->name("worker " + std::to_string(id));
 
 	while(true){
 		bool idle = true;
-		std::unique_lock<std::mutex> ul(tasks_mtx);
+		std::unique_lock<std::mutex> ul(tasks_mtx, std::defer_lock);
+		traced_lock(ul, P->trace);
+
+		if(P->checkpointing)
+			P->paths[id].active = false;
 
 		if(dismiss)
 			dismiss = false;
@@ -67,11 +177,22 @@ void Pool::work(int id){
 				idle = false;
 			else if(--workers == 0 /* && tasks.empty() */ )
 				terminate();
+
+			// a worker waiting to save the search may be waiting on this one
+			if(pausing)
+				pause_cv.notify_all();
 		}
 
-		while(!stop && tasks.empty()){
-			assert_with_log(idle == true, "");
-			cv.wait(ul);
+		// the time a worker waits for a task is recorded as idle
+		if(!stop && tasks.empty()){
+			TraceScope scope(P->trace, "idle");
+
+			while(!stop && tasks.empty()){
+				assert_with_log(idle == true, "");
+				waiting++;
+				cv.wait(ul);
+				waiting--;
+			}
 		}
 
 		if(stop)
@@ -82,22 +203,43 @@ void Pool::work(int id){
 
 		Task task = tasks.top();
 		tasks.pop();
+		queued--;
+
+		if(P->trace)
+			P->trace->instant("pop", "queued", queued);
+
+		if(P->checkpointing)
+			start_path(task_subproblem(task, P), id, P);
+
 		ul.unlock();
 
-		hvc_s *hvcs = build(task.S, task.subset, aux1, task.subset_size, 0, P->n, P->dim, P->ref, false);
-		hvc_s *full = build(task.S+task.cur_pos, task.subset, aux1, task.subset_size, P->n - task.cur_pos, P->n, P->dim, P->ref, true);
+		// the buffers of a task are first touched by the worker that created it
+		if(pinned){
+			Task local = snapshot(task.S, task.subset, task.C, task.Ce, task.Cr, task.hv, task.ubound1, task.cur_pos, task.subset_size, task.is_new);
+			release(task);
+			task = local;
+		}
 
-		branch(task.S+task.cur_pos, task.subset+task.subset_size, task.subset, aux1, task.S, task.C, task.Ce, task.Cr, aux2, task.is_new, task.hv, task.ubound1, id, this, hvcs, full, P);
+		ThreadStats &stats = P->stats[id];
+		const long int nodes = stats.nodes;
 
-		delete [] task.S; delete [] task.subset;
-		delete [] task.C; delete [] task.Ce; delete [] task.Cr;
+		// once the search is stopped the remaining tasks are only released
+		{
+			TraceScope scope(P->trace, "task", "nodes");
+			CounterScope counter(KERNEL_WORK);
 
-		if(P->dim == 3){
-			dealloc(hvcs);
-			dealloc(full);
+			if(!P->stopped)
+				explore(task, aux1, aux2, id, this, P);
+
+			release(task);
+			scope.value = stats.nodes - nodes;
 		}
 
-		P->ntasks++;
+		traced_lock(ul, P->trace);
+		P->task_sizes[std::min(63, (int) std::log2(stats.nodes - nodes + 1))]++;
+		ul.unlock();
+
+		count(stats.tasks);
 	}
 }
 
@@ -162,6 +304,8 @@ void test(Point *S, Point *cur, Point *subset, Point *aux1, double *C, double &h
 
 // check if the hypervolume of the first set with the second set reaches best
 double bound1(Point *cur, Point *subset, Point *aux1, double *Cr, double *Ce, double *aux2, double &ubound1, int subset_size, int points_left, int cur_pos, bool is_new, hvc_s *full, Problem *P){
+	CounterScope scope(KERNEL_BOUND1);
+
 	const int missing = P->k - subset_size;
 	const int excess = points_left - missing;
 	assert_with_log(excess >= 0, "invalid negative excess");
@@ -183,13 +327,10 @@ double bound1(Point *cur, Point *subset, Point *aux1, double *Cr, double *Ce, do
 			double all[all_size], *tmp = all+subset_size;
 
 			if(P->dim == 3){
-				double *contribs = getContributions(full);
-				int *selected = getSelected(full);
-				assert_with_log(all_size == getSize(full), "");
-
-				for(int i = 0; i < all_size; ++i)
-					if(!selected[i] /* if not in the subset */ )
-						*tmp++ = contribs[i];
+				// only the contributions of the points that are not in the subset are needed. full keeps
+				// a list of them, restored by rollback, so the points already accepted are not visited
+				tmp += getUnselectedContributions(full, tmp);
+				assert_with_log(all_size == getSize(full) && tmp == all+all_size, "");
 			}
 
 			if(P->dim != 3){
@@ -214,6 +355,8 @@ double bound1(Point *cur, Point *subset, Point *aux1, double *Cr, double *Ce, do
 }
 
 double bound2(double *C, double *aux2, double &hv, int subset_size, int points_left, int cur_pos, Problem *P){
+	CounterScope scope(KERNEL_BOUND2);
+
 	const int missing = P->k - subset_size;
 
 	std::copy(C+cur_pos, C+P->n, aux2);
@@ -274,6 +417,8 @@ double bound2_extension(Point *S, Point *subset, Point *aux1, double *C, double
 }
 
 void update(Point *next, Point *subset, Point *aux1, double *C, double hv, int subset_size, int cur_pos, int next_pos, int points_left, hvc_s *hvcs, Problem *P){
+	CounterScope scope(KERNEL_UPDATE);
+
 	if(P->dim == 3)
 		update_contributions(next, points_left, hvcs, C+next_pos);
 
@@ -292,13 +437,13 @@ void restore_current(double *Ce, double *cur_point, int cur_pos, hvc_s *full, Pr
 	if(P->dim != 3)
 		return;
 
-	const int pos = findPointPos(full, cur_point);
-	double *Ce_ = getContributions(full);
-	assert_with_log(pos >= 0, "failed to find current point");
+	const int id = findPointId(full, cur_point);
+	assert_with_log(id >= 0, "failed to find current point");
+	const double contribution = contributionAt(full, id);
 
 	// NOTE: finding the position of the contribution by value should be avoided
 	for(int p = cur_pos; p < P->n; ++p){
-		if(eq__(Ce[p], Ce_[pos])){
+		if(eq__(Ce[p], contribution)){
 			std::iter_swap(Ce+cur_pos, Ce+p);
 			return;
 		}
@@ -321,27 +466,160 @@ void swap_next(Point *S, double *C, double *Ce, double *Cr, int pos1, int pos2,
 	std::iter_swap(Cr+pos1, Cr+pos2);
 }
 
+// best hypervolume known by a thread. in deterministic mode a task only sees the solutions of the
+// other tasks of its epoch at its sync points
+inline double incumbent(Problem *P, int id){
+	return P->deterministic ? std::max(P->stats[id].best, P->stats[id].shared) : P->best;
+}
+
+// sync point of a task of the deterministic search. the task publishes its best hypervolume and takes
+// the best of the earlier tasks of its epoch at the same sync point, or at their end, waiting for
+// those that have not reached it. the incumbents a task sees thus depend on its own nodes only, and
+// the earliest task that has not ended never waits
+void deterministic_sync(ThreadStats &stats, Problem *P){
+	EpochShare &share = *P->epoch;
+	const size_t t = stats.task - share.first;
+	std::unique_lock<std::mutex> ul(share.mtx);
+
+	share.published[t].push_back(stats.best);
+	const size_t sync = share.published[t].size();
+	share.cv.notify_all();
+
+	for(size_t e = 0; e < t; ++e){
+		const std::vector<double> &published = share.published[e];
+		share.cv.wait(ul, [&]{ return share.done[e] || published.size() >= sync; });
+		stats.shared = std::max(stats.shared, published[std::min(sync, published.size()) - 1]);
+	}
+}
+
+// the policies decide if a child of a node is handed to the pool. a task costs a snapshot of the
+// node and two calls to build(), which is not worth it for small subtrees. idle is the default since it
+// is the rule of the search before the policies, so the default explores the same tasks as before
+bool split_idle(const SplitNode &node, Pool *pool, Problem *P){
+	return pool->working() < P->cores && P->best > 0.0 && node.subset_size > 0;
+}
+
+bool split_cutoff(const SplitNode &node, Pool *pool, Problem *P){
+	return node.points_left >= P->split_cutoff && split_idle(node, pool, P);
+}
+
+// number of subsets of the subtree scaled by the part of the gap of its bound that is above the best
+// solution. a subtree with a small gap is likely to be pruned early
+double subtree_estimate(const SplitNode &node, Problem *P){
+	const int missing = P->k - node.subset_size;
+	const double subsets = std::exp(std::lgamma(node.points_left + 1.0) - std::lgamma(missing + 1.0) - std::lgamma(node.points_left - missing + 1.0));
+	const double gap = node.bound > node.hv ? (node.bound - P->best) / (node.bound - node.hv) : 0.0;
+	return subsets * std::max(0.0, std::min(1.0, gap));
+}
+
+bool split_estimate(const SplitNode &node, Pool *pool, Problem *P){
+	return subtree_estimate(node, P) >= std::exp2(P->split_cutoff) && split_idle(node, pool, P);
+}
+
+// splits on demand, only while more workers wait for a task than there are tasks queued
+bool split_hunger(const SplitNode &node, Pool *pool, Problem *P){
+	return node.points_left >= P->split_cutoff && pool->hungry() && P->best > 0.0 && node.subset_size > 0;
+}
+
+const SplitPolicy split_policies__[] = {split_idle, split_cutoff, split_estimate, split_hunger};
+
+// bound2 first and the accept branch first, as outside of the portfolio
+const Config default_config__ {"bound2-accept", false, false};
+
+// tasks of an epoch of the deterministic search, which is the most threads it keeps busy. it does not
+// depend on the number of threads, so that the search is the same for any of them. the search is
+// split at the depth that has up to four times as many nodes
+const size_t deterministic_width__ = 64;
+const int deterministic_depth__ = 8;
+
+// nodes a task of the deterministic search explores between two of its sync points
+const long int deterministic_sync__ = 256;
+
+// evaluates a bound. with '--profile' its evaluation and the time it took are counted
+template <typename Bound> inline double profiled(Bound bound, long int DepthProfile::*evals, double DepthProfile::*time, DepthProfile *profile){
+	if(!profile)
+		return bound();
+
+	const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	const double b = bound();
+	const duration<double, std::nano> elapsed = high_resolution_clock::now() - t0;
+
+	profile->*evals += 1;
+	profile->*time += elapsed.count();
+	return b;
+}
+
 // TODO: later use the Task struct as the node. the code will need to be fully refactored
 void branch(Point *cur, Point *end, Point *subset, Point *aux1, Point *S, double *C, double *Ce, double *Cr, double *aux2, bool is_new, double hv, double ubound1, int id, Pool *pool, hvc_s *hvcs, hvc_s *full, Problem *P){
 	const int subset_size = gap(subset, end);
 	const int cur_pos     = gap(S, cur);
 	const int points_left = P->n - cur_pos;
 	const int next_pos    = cur_pos+1;
-	P->nodes[id]++;
+	ThreadStats &stats = P->stats[id];
+	const Config &config = P->portfolio.empty() ? default_config__ : P->portfolio[id];
+	DepthProfile *profile = P->profiling ? &P->profiles[id][cur_pos] : nullptr;
+	count(stats.nodes);
+	if(profile)
+		profile->nodes++;
+	if(P->epoch && ++stats.task_nodes % deterministic_sync__ == 0)
+		deterministic_sync(stats, P);
 	ping(P, id);
 
+	// safe point where the search can be saved. with a stop point the search is checked at every node
+	if(P->checkpointing && !P->stopped && (P->stop_after > 0 || (stats.nodes.load(std::memory_order_relaxed) & 1023) == 0 || (pool && pool->saving()))){
+		std::vector<Task> none;
+
+		if(pool)
+			pool->save();
+		else if(checkpoint_due(P))
+			save_checkpoint(none, P);
+	}
+
+	// a cancelled search stops at once, or once it is saved when it is checkpointed
+	if(!P->checkpointing && cancelled(P))
+		P->stopped = true;
+	if(P->stopped)
+		return;
+
 #ifndef NDEBUG
 	test(S, cur, subset, aux1, C, hv, ubound1, subset_size, points_left, cur_pos, is_new, P);
 #endif
 
 	if(subset_size == P->k){
+		count(stats.leaves);
+		if(profile)
+			profile->leaves++;
+
+		// in deterministic mode the solutions of a task are only merged at the end of its epoch
+		if(P->deterministic){
+			if(hv > incumbent(P, id)){
+				count(stats.incumbents);
+				if(profile)
+					profile->incumbents++;
+				if(P->trace)
+					P->trace->instant("incumbent", "hypervolume", hv);
+				stats.best = hv;
+				std::copy(subset, end, P->local_solution.begin() + id * P->k);
+			}
+
+			return;
+		}
+
 		// guard invalidating new best solutions when two or more are found at the same time
 		std::lock_guard<std::mutex> lg(P->solution_mtx);
 
 		if(hv > P->best){
+			count(stats.incumbents);
+			if(profile)
+				profile->incumbents++;
+			if(P->trace)
+				P->trace->instant("incumbent", "hypervolume", hv);
 			P->best = hv;
-			search_info("new", P, id);
 			std::copy(subset, end, P->solution);
+			search_info("new", P, id);
+
+			if(P->new_best)
+				P->new_best(P);
 		}
 
 		return;
@@ -352,10 +630,34 @@ void branch(Point *cur, Point *end, Point *subset, Point *aux1, Point *S, double
 	if(subset_size + points_left < P->k)
 		return;
 
-	if(bound2(C, aux2, hv, subset_size, points_left, cur_pos, P) <= P->best)
-		return;
-	if(bound1(cur, subset, aux1, Cr, Ce, aux2, ubound1, subset_size, points_left, cur_pos, is_new, full, P) <= P->best)
+	double b1 = INF, b2 = INF;
+
+	// a search of the portfolio may try the tighter but more expensive bound1 first
+	if(config.bound1_first){
+		b1 = profiled([&](){ return bound1(cur, subset, aux1, Cr, Ce, aux2, ubound1, subset_size, points_left, cur_pos, is_new, full, P); }, &DepthProfile::bound1_evals, &DepthProfile::bound1_time, profile);
+		if(b1 <= incumbent(P, id)){
+			count(stats.pruned_bound1);
+			if(profile)
+				profile->bound1_prunes++;
+			return;
+		}
+	}
+	b2 = profiled([&](){ return bound2(C, aux2, hv, subset_size, points_left, cur_pos, P); }, &DepthProfile::bound2_evals, &DepthProfile::bound2_time, profile);
+	if(b2 <= incumbent(P, id)){
+		count(stats.pruned_bound2);
+		if(profile)
+			profile->bound2_prunes++;
 		return;
+	}
+	if(!config.bound1_first){
+		b1 = profiled([&](){ return bound1(cur, subset, aux1, Cr, Ce, aux2, ubound1, subset_size, points_left, cur_pos, is_new, full, P); }, &DepthProfile::bound1_evals, &DepthProfile::bound1_time, profile);
+		if(b1 <= incumbent(P, id)){
+			count(stats.pruned_bound1);
+			if(profile)
+				profile->bound1_prunes++;
+			return;
+		}
+	}
 	//if(bound2_extension(S, subset, aux1, C, hv, subset_size, points_left, cur_pos, P) <= P->best)
 	//	return;
 	/*if(bound3(S, subset, aux1, C, aux2, hv, subset_size, cur_pos, points_left, P) <= P->best){
@@ -372,49 +674,127 @@ void branch(Point *cur, Point *end, Point *subset, Point *aux1, Point *S, double
 	double *cur_point = cur->values;
 	restore_current(Ce, cur_point, cur_pos, full, P);
 
-	if(P->dim == 3 && hvcs)
-		addPoint(hvcs, cur_point, 0);
-	if(P->dim == 3 && full)
-		enablePoint(full, cur_point);
+	const SplitNode node {hv, std::min(b1, b2), subset_size, points_left};
+	const SplitPolicy split = split_policies__[P->split];
 
-	// accept the current point
-	*end = *cur;
+	auto accept = [&](){
+		// the changes made to both structures from here on are undone with a rollback
+		int hvcs_cp = -1, full_cp = -1;
 
-	// update the hypervolume contributions given the newly accepted point
-	update(cur+1, subset, aux1, C, hv, subset_size+1, cur_pos, next_pos, points_left-1, hvcs, P);
+		if(P->dim == 3){
+			CounterScope scope(KERNEL_HVC);
+			hvcs_cp = hvcs ? checkpoint(hvcs) : -1;
+			full_cp = full ? checkpoint(full) : -1;
+
+			if(hvcs)
+				addPoint(hvcs, cur_point, 0);
+			if(full)
+				enablePoint(full, cur_point);
+		}
 
-	const int accept_pos = next_pos + argmax(C+next_pos, points_left - 1);
-	const int ignore_pos = next_pos + argmax(Cb+next_pos, points_left - 1);
+		// accept the current point
+		*end = *cur;
 
-	if(P->cores > 1 && pool && pool->working() < P->cores && P->best > 0.0 && subset_size > 0){
-		swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
-		pool->schedule(S, subset, C, Ce, Cr, hv + C[cur_pos], ubound1, next_pos, subset_size+1, true);
-		swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
-	}
-	else {
-		swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
-		branch(cur+1, end+1, subset, aux1, S, C, Ce, Cr, aux2, true, hv + C[cur_pos], ubound1, id, pool, hvcs, full, P);
-		swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
-	}
+		if(P->checkpointing)
+			P->paths[id].frames.push_back({point_index(cur, P), true});
+
+		// update the hypervolume contributions given the newly accepted point
+		update(cur+1, subset, aux1, C, hv, subset_size+1, cur_pos, next_pos, points_left-1, hvcs, P);
 
-	if(P->dim == 3 && hvcs)
-		removePointAt(hvcs, subset_size, 0); // removePoint(hvcs, cur_point, 0);
-	if(P->dim == 3 && full)
-		removePoint(full, cur_point, 0); // disablePoint(full, cur_point); is superfluous
+		const int accept_pos = next_pos + argmax(C+next_pos, points_left - 1);
 
-	if(P->cores > 1 && pool && pool->working() < P->cores && P->best > 0.0 && subset_size > 0){
-		swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
-		pool->schedule(S, subset, Cb, Ce, Cr, hv, ubound1 - Ce[cur_pos], next_pos, subset_size, false);
-		swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+		if(P->cores > 1 && pool && split(node, pool, P)){
+			swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
+			pool->schedule(S, subset, C, Ce, Cr, hv + C[cur_pos], ubound1, next_pos, subset_size+1, true);
+			swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
+		}
+		else if(P->frontier && next_pos == P->frontier_pos){
+			swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
+			P->frontier->push_back(node_task(S, subset, C, Ce, Cr, hv + C[cur_pos], ubound1, next_pos, subset_size+1, true, P));
+			swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
+		}
+		else {
+			const long int nodes = stats.nodes.load(std::memory_order_relaxed);
+
+			swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
+			branch(cur+1, end+1, subset, aux1, S, C, Ce, Cr, aux2, true, hv + C[cur_pos], ubound1, id, pool, hvcs, full, P);
+			swap_next(S, C, Ce, Cr, next_pos, accept_pos, P);
+
+			if(profile){
+				profile->accepts++;
+				profile->accept_nodes += stats.nodes.load(std::memory_order_relaxed) - nodes;
+			}
+		}
+
+		if(P->dim == 3){
+			CounterScope scope(KERNEL_HVC);
+
+			if(hvcs)
+				rollback(hvcs, hvcs_cp);
+			if(full)
+				rollback(full, full_cp);
+		}
+		if(P->checkpointing)
+			P->paths[id].frames.pop_back();
+	};
+
+	auto ignore = [&](){
+		int full_cp = -1;
+
+		if(P->dim == 3 && full){
+			CounterScope scope(KERNEL_HVC);
+			full_cp = checkpoint(full);
+			removePoint(full, cur_point, 0);
+		}
+		if(P->checkpointing)
+			P->paths[id].frames.push_back({point_index(cur, P), false});
+
+		const int ignore_pos = next_pos + argmax(Cb+next_pos, points_left - 1);
+
+		if(P->cores > 1 && pool && split(node, pool, P)){
+			swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+			pool->schedule(S, subset, Cb, Ce, Cr, hv, ubound1 - Ce[cur_pos], next_pos, subset_size, false);
+			swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+		}
+		else if(P->frontier && next_pos == P->frontier_pos){
+			swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+			P->frontier->push_back(node_task(S, subset, Cb, Ce, Cr, hv, ubound1 - Ce[cur_pos], next_pos, subset_size, false, P));
+			swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+		}
+		else {
+			const long int nodes = stats.nodes.load(std::memory_order_relaxed);
+
+			swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+			branch(cur+1, end+0, subset, aux1, S, Cb, Ce, Cr, aux2, false, hv, ubound1 - Ce[cur_pos], id, pool, hvcs, full, P);
+			swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+
+			if(profile){
+				profile->ignores++;
+				profile->ignore_nodes += stats.nodes.load(std::memory_order_relaxed) - nodes;
+			}
+		}
+
+		if(P->dim == 3 && full){
+			CounterScope scope(KERNEL_HVC);
+			rollback(full, full_cp);
+		}
+		if(P->checkpointing)
+			P->paths[id].frames.pop_back();
+	};
+
+	if(config.ignore_first){
+		// the ignore branch recomputes the exclusive contributions without the current point, while
+		// the accept branch still needs them with it
+		double Ceb[P->n];
+		std::copy(Ce+next_pos, Ce+P->n, Ceb+next_pos);
+		ignore();
+		std::copy(Ceb+next_pos, Ceb+P->n, Ce+next_pos);
+		accept();
 	}
 	else {
-		swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
-		branch(cur+1, end+0, subset, aux1, S, Cb, Ce, Cr, aux2, false, hv, ubound1 - Ce[cur_pos], id, pool, hvcs, full, P);
-		swap_next(S, Cb, Ce, Cr, next_pos, ignore_pos, P);
+		accept();
+		ignore();
 	}
-
-	if(P->dim == 3 && full)
-		addPoint(full, cur_point, 0);
 }
 
 // decremental greedy
@@ -438,6 +818,27 @@ void heuristic(Point *S, Point *aux1, double *aux2, double full, Problem *P){
 	}
 }
 
+// decremental greedy down to a single point. the first s points of order are the greedy subset of
+// size s and volumes[s] is its hypervolume, or -INF when the greedy is not available
+void greedy_trajectory(Point *S, Point *order, std::vector<double> &volumes, double full, Problem *P){
+	double aux2[P->n];
+
+	std::copy(S, S + P->n, order);
+	volumes.assign(P->n + 1, -INF);
+	volumes[P->n] = full;
+
+	if(P->dim != 3 && P->dim != 4)
+		return;
+
+	for(int s = P->n; s > 1; --s){
+		all_contributions(order, s, P->dim, P->ref, aux2);
+		const int minp = argmin(aux2, s);
+		std::iter_swap(order+minp, order+s-1);
+		full -= aux2[minp];
+		volumes[s-1] = full;
+	}
+}
+
 void compute_root_contributions(Point *S, Point *subset, Point *aux1, double *C, double *Ce, double *Cr, Problem *P){
 	if(P->dim == 3){
 		get_contributions(S, subset, 0, P->n, P->dim, P->ref, C);
@@ -453,6 +854,12 @@ void compute_root_contributions(Point *S, Point *subset, Point *aux1, double *C,
 
 		double *it = Ce;
 		for(int i = 0; i < P->n; i++){
+			// exclusive contribution of a previous solve that the changes of the archive left exact
+			if(!P->contributions.empty() && P->contributions[point_index(S+i, P)] >= 0.0){
+				*it++ = P->contributions[point_index(S+i, P)];
+				continue;
+			}
+
 			std::copy(S, S + P->n, aux1);
 			std::iter_swap(aux1+0, aux1+i);
 			*it++ = hs - hypervolume(aux1+1, P->n-1, P->dim, P->ref);
@@ -462,12 +869,230 @@ void compute_root_contributions(Point *S, Point *subset, Point *aux1, double *C,
 	std::copy(Ce, Ce+P->n, Cr);
 }
 
-double root(Problem *P){
+// rebuilds the node of the search tree of a saved subproblem. the points that were already decided
+// are placed before the current position and are no longer used by the search
+Task restore_task(const Subproblem &sp, double *Cr, Problem *P){
+	Task task {
+		new Point[P->n], new Point[P->k],
+		new double[P->n], new double[P->n], new double[P->n], 0.0, 0.0,
+		P->n - (int) sp.remaining.size(), (int) sp.accepted.size(),
+		false
+	};
+
+	Point aux1[P->n];
+	bool remaining[P->n];
+	std::fill(remaining, remaining + P->n, false);
+
+	for(int i : sp.remaining)
+		remaining[i] = true;
+	for(int i = 0; i < (int) sp.accepted.size(); ++i)
+		task.subset[i] = P->X[sp.accepted[i]];
+
+	int decided = 0, pos = task.cur_pos;
+	for(int i = 0; i < P->n; ++i){
+		if(remaining[i]){
+			task.S[pos] = P->X[i];
+			task.Cr[pos] = task.Ce[pos] = Cr[i];
+			pos++;
+		}
+		else
+			task.S[decided++] = P->X[i];
+	}
+
+	std::copy(task.subset, task.subset + task.subset_size, aux1);
+	task.hv = hypervolume(aux1, task.subset_size, P->dim, P->ref);
+
+	for(int i = task.cur_pos; i < P->n; ++i)
+		task.C[i] = contribution(task.S+i, task.subset, aux1, task.subset_size, task.hv, P);
+
+	std::copy(task.subset, task.subset + task.subset_size, aux1);
+	std::copy(task.S + task.cur_pos, task.S + P->n, aux1 + task.subset_size);
+	task.ubound1 = hypervolume(aux1, task.subset_size + P->n - task.cur_pos, P->dim, P->ref);
+
+	// the search expects the maximal contributor at the current position
+	if(task.cur_pos < P->n)
+		swap_next(task.S, task.C, task.Ce, task.Cr, task.cur_pos, task.cur_pos + argmax(task.C + task.cur_pos, P->n - task.cur_pos), P);
+
+	return task;
+}
+
+void root_contributions(double *C, double *Cr, Problem *P){
 	Point S[P->n], subset[P->k], aux1[P->n];
-	double C[P->n], Ce[P->n], Cr[P->n], aux2[P->n];
+	double Ce[P->n];
 
 	std::copy(P->X, P->X + P->n, S);
 	compute_root_contributions(S, subset, aux1, C, Ce, Cr, P);
+}
+
+// searches the given subproblems starting from the current best solution. Cr holds the root
+// exclusive hypervolume contributions in the initial order of the points
+void search_subproblems(const std::vector<Subproblem> &open, double *Cr, Problem *P){
+	std::vector<Task> tasks;
+
+	for(const Subproblem &sp : open)
+		if((int) (sp.accepted.size() + sp.remaining.size()) >= P->k && (int) sp.accepted.size() <= P->k)
+			tasks.push_back(restore_task(sp, Cr, P));
+
+	if(P->cores > 1){
+		Pool pool(P);
+		pool.schedule(tasks);
+		pool.join();
+		return;
+	}
+
+	Point aux1[P->n];
+	double aux2[P->n];
+
+	for(Task &task : tasks){
+		if(P->checkpointing)
+			start_path(task_subproblem(task, P), 0, P);
+		if(!P->stopped)
+			explore(task, aux1, aux2, 0, nullptr, P);
+
+		release(task);
+	}
+}
+
+// explores the nodes of the search tree at a fixed depth in epochs of a fixed number of tasks without
+// splitting them further. the nodes are found by the search itself on one thread, so they are those
+// the sequential search reaches and in its order, which finds good solutions early. the tasks of an
+// epoch see the best solution known when the epoch started, their own ones and those the earlier
+// tasks of the epoch published at their sync points, and their solutions are merged in task order at
+// the end of the epoch. the search is thus the same for any number of threads and any timing
+void deterministic_search(double *Cr, Problem *P){
+	Subproblem all {{}, std::vector<int>(P->n)};
+	std::iota(all.remaining.begin(), all.remaining.end(), 0);
+
+	std::vector<Task> tasks;
+	Task root = restore_task(all, Cr, P);
+
+	P->local_solution.resize(P->cores * P->k);
+	P->stats[0].best = P->stats[0].shared = P->best;
+	P->frontier = &tasks;
+	P->frontier_pos = deterministic_depth__;
+
+	{
+		Point aux1[P->n];
+		double aux2[P->n];
+		explore(root, aux1, aux2, 0, nullptr, P);
+		release(root);
+	}
+
+	P->frontier = nullptr;
+
+	// the subsets found above the depth of the tasks
+	if(P->stats[0].best > P->best){
+		P->best = P->stats[0].best;
+		std::copy(P->local_solution.begin(), P->local_solution.begin() + P->k, P->solution);
+		search_info("new", P, 0);
+	}
+
+	std::vector<double> best(tasks.size());
+	std::vector<Point> solution(tasks.size() * P->k);
+
+	for(size_t first = 0; first < tasks.size(); first += deterministic_width__){
+		const size_t last = std::min(tasks.size(), first + deterministic_width__);
+		std::atomic<size_t> next(first);
+		std::vector<std::thread> threads;
+		EpochShare share;
+
+		share.first = first;
+		share.published.resize(last - first);
+		share.done.assign(last - first, false);
+		P->epoch = &share;
+
+		auto work = [&](int id){
+			Point aux1[P->n];
+			double aux2[P->n];
+			ThreadStats &stats = P->stats[id];
+			ThreadCounting counting(P->counting ? &P->counters[id] : nullptr);
+
+			for(size_t t = next++; t < last; t = next++){
+				stats.best = stats.shared = P->best;
+				stats.task = t;
+				stats.task_nodes = 0;
+
+				explore(tasks[t], aux1, aux2, id, nullptr, P);
+				release(tasks[t]);
+				count(stats.tasks);
+
+				best[t] = stats.best;
+				std::copy(P->local_solution.begin() + id * P->k, P->local_solution.begin() + (id + 1) * P->k, solution.begin() + t * P->k);
+
+				std::lock_guard<std::mutex> lg(share.mtx);
+				share.published[t - first].push_back(stats.best);
+				share.done[t - first] = true;
+				share.cv.notify_all();
+			}
+		};
+
+		for(int id = 0; id < P->cores; ++id)
+			threads.push_back(std::thread(work, id));
+		for(std::thread &t : threads)
+			t.join();
+
+		P->epoch = nullptr;
+
+		for(size_t t = first; t < last; ++t){
+			if(best[t] > P->best){
+				P->best = best[t];
+				std::copy(solution.begin() + t * P->k, solution.begin() + (t + 1) * P->k, P->solution);
+				search_info("new", P, 0);
+			}
+		}
+	}
+}
+
+// races the searches of the portfolio from the root on one thread each. they share the best solution,
+// so the first search to finish has proved it optimal and the others are stopped
+void portfolio_search(double *Cr, Problem *P){
+	Subproblem all {{}, std::vector<int>(P->n)};
+	std::iota(all.remaining.begin(), all.remaining.end(), 0);
+
+	std::vector<Task> tasks;
+	std::vector<std::thread> threads;
+
+	for(int id = 0; id < P->cores; ++id)
+		tasks.push_back(restore_task(all, Cr, P));
+
+	auto work = [&](int id){
+		Point aux1[P->n];
+		double aux2[P->n];
+		ThreadCounting counting(P->counting ? &P->counters[id] : nullptr);
+
+		explore(tasks[id], aux1, aux2, id, nullptr, P);
+		release(tasks[id]);
+
+		if(!P->stopped.exchange(true))
+			P->winner = id;
+	};
+
+	for(int id = 0; id < P->cores; ++id)
+		threads.push_back(std::thread(work, id));
+	for(std::thread &t : threads)
+		t.join();
+
+	// the search is complete once any of the searches finished, unless all of them were cancelled
+	P->stopped = P->winner < 0;
+}
+
+// continues the search from the best solution and the open subproblems of a checkpoint
+void resume_search(Checkpoint *checkpoint, double *Cr, Problem *P){
+	P->best = checkpoint->solution.empty() ? -INF : checkpoint->best;
+	for(int i = 0; i < (int) checkpoint->solution.size(); ++i)
+		P->solution[i] = P->X[checkpoint->solution[i]];
+
+	count(P->stats[0].nodes, checkpoint->nodes);
+	count(P->stats[0].tasks, checkpoint->ntasks);
+
+	search_subproblems(checkpoint->open, Cr, P);
+}
+
+// searches from the root node of the points in S, given their root contributions and hypervolume.
+// the greedy solution is skipped when the best solution was seeded before
+double search_root(Point *S, double *C, double *Ce, double *Cr, double hs, Checkpoint *checkpoint, bool greedy, Problem *P){
+	Point subset[P->k], aux1[P->n];
+	double aux2[P->n];
 
 	if(P->k == 1){
 		const int maxp = argmax(C, P->n);
@@ -484,17 +1109,39 @@ double root(Problem *P){
 		std::iter_swap(P->solution+minp, P->solution + P->n - 1);
 		P->best = hypervolume(S, P->n, P->dim, P->ref) - Ce[minp];
 	}
+	else if(checkpoint){
+		resume_search(checkpoint, Cr, P);
+	}
+	else if(!P->portfolio.empty()){
+		heuristic(S, aux1, aux2, hs, P);
+		portfolio_search(Cr, P);
+	}
+	else if(P->deterministic){
+		heuristic(S, aux1, aux2, hs, P);
+		deterministic_search(Cr, P);
+	}
+	else if(!P->serve_address.empty()){
+		heuristic(S, aux1, aux2, hs, P);
+		serve_workers(split_search(C, 16 * P->cores, P), P);
+	}
 	else {
-		std::copy(S, S + P->n, aux1);
 		const int r = argmax(C, P->n);
-		const double hs = hypervolume(aux1, P->n, P->dim, P->ref);
 
-		heuristic(S, aux1, aux2, hs, P);
+		if(greedy)
+			heuristic(S, aux1, aux2, hs, P);
 		swap_next(S, C, Ce, Cr, 0, r, P);
 
 		if(P->cores == 1){
+			ThreadCounting counting(P->counting ? &P->counters[0] : nullptr);
 			hvc_s *hvcs = build(S, subset, aux1, 0, 0, P->n, P->dim, P->ref, false);
 			hvc_s *full = build(S, subset, aux1, 0, P->n, P->n, P->dim, P->ref, true);
+
+			if(P->checkpointing){
+				Subproblem all {{}, std::vector<int>(P->n)};
+				std::iota(all.remaining.begin(), all.remaining.end(), 0);
+				start_path(all, 0, P);
+			}
+
 			branch(S, subset, subset, aux1, S, C, Ce, Cr, aux2, false, 0.0, hs, 0, nullptr, hvcs, full, P);
 
 			if(P->dim == 3 && hvcs)
@@ -511,35 +1158,288 @@ double root(Problem *P){
 		swap_next(S, C, Ce, Cr, 0, r, P);
 	}
 
-	search_info("end", P, 0);
+	search_info(P->stopped ? "stop" : "end", P, 0);
 	concurrency_info(P);
+	profile_info(P);
 	return P->best;
 }
 
-double hssp(std::vector<std::string> args, std::vector<int> &sol, long int &nodes){
+double root(Problem *P, Checkpoint *checkpoint){
+	Point S[P->n], subset[P->k], aux1[P->n];
+	double C[P->n], Ce[P->n], Cr[P->n];
+
+	std::copy(P->X, P->X + P->n, S);
+	reuse_contributions(P);
+	compute_root_contributions(S, subset, aux1, C, Ce, Cr, P);
+	P->contributions.assign(Cr, Cr + P->n);
+	warm_incumbent(P);
+	std::copy(S, S + P->n, aux1);
+
+	return search_root(S, C, Ce, Cr, hypervolume(aux1, P->n, P->dim, P->ref), checkpoint, true, P);
+}
+
+// problem of one subset size of a sweep. it shares the points of the sweep and is searched on a
+// single thread
+void init_sweep_problem(Problem *Q, int k, Problem *P){
+	init_problem(Q);
+	Q->X = P->X;
+	Q->ref = P->ref;
+	Q->n = P->n;
+	Q->dim = P->dim;
+	Q->maximize = P->maximize;
+	Q->split = P->split;
+	Q->cancel = P->cancel;
+	Q->k = k;
+	Q->kset = true;
+	Q->initialized = true;
+	Q->solution = new_points(Q->n, Q->dim, false);
+	Q->stats = new ThreadStats[Q->cores]();
+	Q->paths.resize(Q->cores);
+	Q->task_sizes.resize(64);
+}
+
+// offers the optimal subset of the size before with its largest contributor as a subset of Q. Q may
+// already be searching, so its solution is replaced under its lock and only when it is better
+void extend_sweep_solution(Problem *Q, const Problem *before){
+	Point aux1[Q->n];
+	bool used[Q->n];
+	double best = -INF;
+	int largest = -1;
+
+	std::fill(used, used + Q->n, false);
+	for(Point *p = before->solution; p != before->solution + before->k; ++p)
+		used[point_index(p, Q)] = true;
+
+	for(int i = 0; i < Q->n; ++i){
+		const double hv = used[i] ? -INF : before->best + contribution(Q->X + i, before->solution, aux1, before->k, before->best, Q);
+
+		if(hv > best){
+			best = hv;
+			largest = i;
+		}
+	}
+
+	std::lock_guard<std::mutex> lg(Q->solution_mtx);
+
+	if(largest >= 0 && best > Q->best){
+		Q->best = best;
+		std::copy(before->solution, before->solution + before->k, Q->solution);
+		Q->solution[before->k] = Q->X[largest];
+	}
+}
+
+// the best known subset of a size is the better of its greedy subset and of the optimal subset of
+// the size before with its largest contributor
+void seed_sweep_problem(Problem *Q, Point *order, const std::vector<double> &greedy, const Problem *before){
+	if(greedy[Q->k] > Q->best){
+		Q->best = greedy[Q->k];
+		std::copy(order, order + Q->k, Q->solution);
+	}
+
+	if(before)
+		extend_sweep_solution(Q, before);
+}
+
+// searches every subset size from 1 to K on the threads of the problem, one size per thread and in
+// increasing order. the sizes share the root contributions and the greedy trajectory, and a size
+// starts from the optimal subset of the size before when that one is already known, or receives it
+// while it searches when the size before ends later. solved is called with the problem of each
+// size, in order of the sizes
+void sweep(int K, std::function<void(Problem *)> solved, Problem *P){
+	Point S[P->n], subset[P->n], aux1[P->n], order[P->n];
+	double C[P->n], Ce[P->n], Cr[P->n];
+	std::vector<double> greedy;
+
+	std::copy(P->X, P->X + P->n, S);
+	compute_root_contributions(S, subset, aux1, C, Ce, Cr, P);
+	std::copy(S, S + P->n, aux1);
+
+	const double hs = hypervolume(aux1, P->n, P->dim, P->ref);
+	greedy_trajectory(S, order, greedy, hs, P);
+
+	std::vector<Problem> problems(K + 1);
+	std::vector<bool> started(K + 1, false), done(K + 1, false);
+	std::vector<std::thread> threads;
+	std::atomic<int> next(1);
+	std::mutex sweep_mtx;
+	int reported = 0;
+
+	auto work = [&](){
+		Point Sk[P->n];
+		double Ck[P->n], Cek[P->n], Crk[P->n];
+
+		for(int k = next++; k <= K && !cancelled(P); k = next++){
+			Problem *Q = &problems[k];
+			init_sweep_problem(Q, k, P);
+
+			// the best subset of Q is seeded before the size before may extend its own into it
+			std::unique_lock<std::mutex> lock(sweep_mtx);
+			const Problem *before = k > 1 && done[k-1] ? &problems[k-1] : nullptr;
+			lock.unlock();
+
+			seed_sweep_problem(Q, order, greedy, before);
+
+			lock.lock();
+			started[k] = true;
+			const bool ended = !before && k > 1 && done[k-1];
+			lock.unlock();
+
+			// the size before ended while Q was seeded
+			if(ended)
+				extend_sweep_solution(Q, &problems[k-1]);
+
+			std::copy(S, S + P->n, Sk);
+			std::copy(C, C + P->n, Ck);
+			std::copy(Ce, Ce + P->n, Cek);
+			std::copy(Cr, Cr + P->n, Crk);
+			search_root(Sk, Ck, Cek, Crk, hs, nullptr, false, Q);
+
+			lock.lock();
+			done[k] = true;
+			const bool next_searching = k < K && started[k+1] && !done[k+1] && !Q->stopped;
+			for(; reported < K && done[reported + 1]; ++reported)
+				solved(&problems[reported + 1]);
+			lock.unlock();
+
+			// the next size is searching without this subset
+			if(next_searching)
+				extend_sweep_solution(&problems[k+1], Q);
+		}
+	};
+
+	for(int t = 0; t < P->cores; ++t)
+		threads.push_back(std::thread(work));
+	for(std::thread &t : threads)
+		t.join();
+
+	for(int k = 1; k <= K; ++k){
+		P->stopped = P->stopped || !done[k] || problems[k].stopped;
+
+		if(problems[k].initialized){
+			delete [] problems[k].solution;
+			delete [] problems[k].stats;
+		}
+	}
+}
+
+// state of a problem before its options are read
+void init_problem(Problem *P){
+	P->t0 = high_resolution_clock::now();
+	P->ping = P->t0;
+	P->best = -INF;
+	P->cores = 1u;
+}
+
+// searches a problem whose options are checked and whose points are loaded
+double solve_problem(Problem *P, Checkpoint *checkpoint){
+	P->stats = new ThreadStats[P->cores]();
+	P->paths.resize(P->cores);
+	P->task_sizes.resize(64);
+	P->checkpoint_time = high_resolution_clock::now();
+
+	if(P->profiling)
+		P->profiles.assign(P->cores, std::vector<DepthProfile>(P->n + 1));
+	if(P->counting)
+		P->counters.assign(P->cores, ThreadCounters {});
+	if(!P->trace_file.empty()){
+		P->trace = new Trace();
+		P->trace->name("search");
+	}
+
+	const double volume = root(P, checkpoint);
+
+	// the trace is written once every thread of the search has ended
+	if(P->trace){
+		if(!P->trace->write(P->trace_file))
+			logger::warn("failed to write trace file '" + P->trace_file + "'");
+
+		delete P->trace;
+		P->trace = nullptr;
+	}
+
+	return volume;
+}
+
+double hssp(std::vector<std::string> args, std::vector<int> &sol, long int &nodes, CancelToken *cancel, bool *stopped){
 	Problem P {};
 	std::ifstream file;
 	std::vector<double> ref;
 
-	P.t0 = high_resolution_clock::now();
-	P.ping = P.t0;
-	P.best = -INF;
-	P.cores = 1u;
+	P.cancel = cancel;
+	if(stopped)
+		*stopped = false;
+
+	init_problem(&P);
 
 	if(!read_args(args, ref, file, &P))
 		return -1;
-	if(!read_input(file, ref, &P))
+	if(!P.daemon_address.empty()){
+		run_daemon(&P);
+		clear_memory(&P);
+		return -1;
+	}
+	if(!P.worker_address.empty()){
+		run_worker(&P);
+		if(stopped)
+			*stopped = P.stopped;
+		clear_memory(&P);
+		return -1;
+	}
+	if(!read_points(P.input_file, file, ref, &P))
 		return -1;
 	if(P.printpointsonly){
 		print_problem(&P);
 		clear_memory(&P);
 		return -1;
 	}
+	if(!P.binary_file.empty()){
+		if(write_binary(P.binary_file, ref, &P))
+			clear_memory(&P);
+		return -1;
+	}
+
+	if(!P.client_address.empty()){
+		const double volume = run_client(&P, sol, nodes);
+		if(stopped)
+			*stopped = P.stopped;
+		if(volume >= 0)
+			clear_memory(&P);
+		return volume;
+	}
+	if(P.all_k){
+		sweep(P.kset ? P.k : P.n, [](Problem *Q){
+			std::cout << Q->k << " " << std::scientific << std::setprecision(15) << Q->best;
+			for(int p : solution_to_vector(Q))
+				std::cout << " " << p;
+
+			std::cout << std::endl;
+		}, &P);
+
+		if(stopped)
+			*stopped = P.stopped;
+		clear_memory(&P);
+		return -1;
+	}
+
+	Checkpoint checkpoint;
+
+	if(!P.resume_file.empty() && !read_checkpoint(P.resume_file, checkpoint, &P)){
+		ERROR(&P, "invalid checkpoint file '" + P.resume_file + "' for this problem\n");
+		return -1;
+	}
+
+	std::ifstream warm(P.warm_file);
+	if(warm.is_open() && !read_warm_start(P.warm_file, ref, &P))
+		logger::warn("ignoring warm start file '" + P.warm_file + "' of another problem");
+
+	const double volume = solve_problem(&P, P.resume_file.empty() ? nullptr : &checkpoint);
+	if(!P.warm_file.empty() && !write_warm_start(P.warm_file, ref, &P))
+		logger::warn("failed to write warm start file '" + P.warm_file + "'");
 
-	P.nodes.resize(P.cores);
-	const double volume = root(&P);
 	sol = solution_to_vector(&P);
-	nodes = std::accumulate(P.nodes.begin(), P.nodes.end(), 0);
+	nodes = total(&P, &ThreadStats::nodes);
+	if(stopped)
+		*stopped = P.stopped;
 	clear_memory(&P);
 	return volume;
 }
@@ -4,10 +4,11 @@
 #include "util.h"
 #include "hypervolume.h"
 #include "nth_subsetsum.h"
+#include "topology.h"
 
 #include <algorithm>          // copy, nth_element, iter_swap, sort, find_if, equal
-#include <functional>         // greater, less
-#include <numeric>            // accumulate
+#include <functional>         // greater, less, function
+#include <numeric>            // accumulate, iota
 #include <chrono>             // high_resolution_clock, now
 #include <sstream>            // stringstream
 #include <cmath>              // exp
@@ -38,15 +39,42 @@ struct Task {
 	}
 };
 
+// node of the search tree given by the initial positions of the points accepted so far and of the
+// points that are still to be decided
+struct Subproblem {
+	std::vector<int> accepted, remaining;
+};
+
+// incumbents that the tasks of an epoch of the deterministic search publish at each of their sync
+// points, and at their end
+struct EpochShare {
+	size_t first; // first task of the epoch
+	std::vector<std::vector<double> > published;
+	std::vector<char> done;
+	std::mutex mtx;
+	std::condition_variable cv;
+};
+
+// node of the search whose children may be handed to the pool
+struct SplitNode {
+	double hv, bound; // hypervolume of the subset and the smallest upper bound of the node
+	int subset_size, points_left;
+};
+
+class Pool;
+typedef bool (*SplitPolicy)(const SplitNode & , Pool * , Problem * );
+
 class Pool {
 	Problem *P;
 	std::mutex tasks_mtx;
-	std::condition_variable cv;
+	std::condition_variable cv, pause_cv;
 	std::priority_queue<Task> tasks;
 	std::vector<std::thread> threads;
+	std::vector<Cpu> placement;
 
-	int workers = 0;
-	std::atomic<bool> stop;
+	int workers = 0, paused = 0;
+	std::atomic<int> waiting, queued;
+	std::atomic<bool> stop, pausing;
 
 public:
 	Pool(Problem * );
@@ -54,11 +82,28 @@ public:
 	void terminate();
 	void work(int );
 	int working();
+	bool hungry();
+	bool saving();
+	void save();
+	void schedule(std::vector<Task> & );
 	void schedule(Point *, Point *, double *, double *, double *, double , double , int , int , bool );
 	Task snapshot(Point *, Point *, double *, double *, double *, double , double , int , int , bool );
 };
 
-double hssp(std::vector<std::string> , std::vector<int> & , long int & );
+struct Checkpoint;
+
+void init_problem(Problem * );
+double solve_problem(Problem * , Checkpoint * );
+void sweep(int , std::function<void(Problem *)> , Problem * );
+double hssp(std::vector<std::string> , std::vector<int> & , long int & , CancelToken * = nullptr , bool * = nullptr );
+Task node_task(Point * , Point * , double * , double * , double * , double , double , int , int , bool , Problem * );
+void release(Task & );
+void explore(Task & , Point * , double * , int , Pool * , Problem * );
+void root_contributions(double * , double * , Problem * );
+double contribution(Point * , Point * , Point * , int , double , Problem * );
+double bound1(Point * , Point * , Point * , double * , double * , double * , double & , int , int , int , bool , hvc_s * , Problem * );
+double bound2(double * , double * , double & , int , int , int , Problem * );
+void search_subproblems(const std::vector<Subproblem> & , double * , Problem * );
 void branch(Point * , Point * , Point * , Point * , Point * , double * , double * , double * , double * , bool , double , double , int , Pool * , hvc_s * , hvc_s * , Problem * );
 
 #endif
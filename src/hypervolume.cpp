@@ -1,4 +1,5 @@
 #include "hypervolume.h"
+#include "counters.h"
 
 double hv2D(Point *S, const int n){
 	std::sort(S, S+n, [](const Point &a, const Point &b){ return a.y() > b.y(); });
@@ -51,6 +52,8 @@ double hypervolume(Point *S, int n, const int dim, const double *ref){
 	if(n <= 0)
 		return 0.0;
 
+	CounterScope scope(KERNEL_HYPERVOLUME);
+
 	switch(dim){
 		// NOTE: hv2D and hv3D are only for maximization
 		//case 2:
@@ -72,6 +75,8 @@ void get_contributions(Point *S, Point *subset, int subset_size, int n, int dim,
 	double data[subset_size*dim];
 	flatten_set(subset, data, subset_size, 1, dim);
 	hvc_s *hvcs = init(data, dim, subset_size, n, ref);
+	if(!hvcs)
+		throw std::bad_alloc();
 
 	for(Point *p = S; p != S+n; ++p)
 		*contributions++ = oneContribution(hvcs, p->values);
@@ -94,7 +99,11 @@ hvc_s *build(Point *S, Point *subset, Point *aux1, int subset_size, int points_l
 
 	double data[all_size*dim];
 	flatten_set(aux1, data, all_size, 1, dim);
+	// the structure of a 3d problem fails only when its nodes can not be allocated, which is reported
+	// as a failed new would be
 	hvc_s *hvcs = init(data, dim, all_size, n, ref);
+	if(!hvcs)
+		throw std::bad_alloc();
 
 	if(!enable_subset)
 		return hvcs;
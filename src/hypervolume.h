@@ -15,6 +15,7 @@ extern "C"
 #include <algorithm> // sort, copy
 #include <iterator>  // prev, next
 #include <set>       // multiset
+#include <new>       // bad_alloc
 
 struct Point2D {
 	double x, y;
@@ -1,20 +1,45 @@
-#include "test.h" // TODO: later remove this include
 #include "hssp.h"
+#include "batch.h"
 
 #include <vector>
 #include <string>
 #include <iostream>
+#include <csignal>
+
+CancelToken interrupt__;
+volatile sig_atomic_t signal__ = 0;
+
+// the first signal stops the search, which still prints the best solution found so far. a second
+// one terminates the program
+void on_signal(int sig){
+	signal__ = sig;
+	interrupt__.cancel();
+	std::signal(sig, SIG_DFL);
+}
 
 int main(int argc, char **argv){
 	std::vector<std::string> args(argv+1, argv+argc);
 
-	// TODO: create main funcion in test.cpp and remove this. needs new make instruction
-	if(contains(args, std::string("--test")))
-		run_validation_tests();
+	if(contains(args, std::string("--batch"))){
+		bool stopped = false;
+
+		std::signal(SIGINT, on_signal);
+		std::signal(SIGTERM, on_signal);
+		const bool read = run_batch(args, &interrupt__, &stopped);
+
+		if(stopped)
+			return signal__ ? 128 + signal__ : 1;
+		if(!read)
+			return 1;
+	}
 	else {
 		long int nodes = 0;
+		bool stopped = false;
 		std::vector<int> solution;
-		double volume = hssp(args, solution, nodes);
+
+		std::signal(SIGINT, on_signal);
+		std::signal(SIGTERM, on_signal);
+		double volume = hssp(args, solution, nodes, &interrupt__, &stopped);
 
 		if(volume >= 0)
 			std::cout << std::scientific << std::setprecision(15) << volume << std::endl;
@@ -22,6 +47,11 @@ int main(int argc, char **argv){
 			std::cout << p << " ";
 
 		std::cout << std::endl;
+
+		// the exit status tells a solution proven optimal from the best one found before the search
+		// was stopped
+		if(stopped)
+			return signal__ ? 128 + signal__ : 1;
 	}
 
 	return 0;
@@ -0,0 +1,305 @@
+#include "parser.h"
+
+const char binary_magic__[8] = {'H', 'S', 'S', 'P', 'B', 'I', 'N', '1'};
+
+// header of a binary instance. the original reference point follows it and the normalized
+// coordinates start at the next multiple of 64 bytes, in the byte order of the machine that wrote them
+struct BinaryHeader {
+	char magic[8];
+	int32_t n, dim, maximize, reserved;
+};
+
+// a part of the mapped file that begins at the start of a line and ends after a newline or at the
+// end of the file
+struct Chunk {
+	const char *begin, *end;
+	long int points = 0, first = 0; // data lines of the chunk and index of its first point
+	bool same_dimension = true, dominated = true;
+};
+
+inline bool is_space(char c){
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char *end_of_line(const char *it, const char *end){
+	const char *eol = (const char *) memchr(it, '\n', end - it);
+	return eol ? eol : end;
+}
+
+inline const char *next_line(const char *eol, const char *end){
+	return eol == end ? end : eol + 1;
+}
+
+// skips the whitespace at the start of a line. a blank line or a comment is skipped as a whole
+inline const char *line_start(const char *it, const char *eol){
+	while(it != eol && is_space(*it))
+		++it;
+
+	return it != eol && *it == '#' ? eol : it;
+}
+
+// parses the next number of a line. as with the stream parser, the rest of the line is ignored from
+// the first token that is not a finite number. inf and nan are told apart by their text, since
+// -ffast-math assumes finite values
+inline bool next_number(const char *&it, const char *eol, double &value){
+	while(it != eol && is_space(*it))
+		++it;
+	if(it != eol && *it == '+' && std::next(it) != eol && *std::next(it) != '-')
+		++it;
+
+	const char *digit = it != eol && *it == '-' ? std::next(it) : it;
+	if(digit == eol || !(isdigit(*digit) || *digit == '.'))
+		return false;
+
+	const std::from_chars_result result = std::from_chars(it, eol, value);
+	if(result.ec != std::errc())
+		return false;
+
+	it = result.ptr;
+	return true;
+}
+
+// parses the coordinates of a line of text with the line handling of the mapped files. a blank or
+// comment line has none. fails when the numbers are followed by text that is not a comment
+bool parse_line(const std::string &line, std::vector<double> &values){
+	const char *it = line.data(), *eol = line.data() + line.size();
+	double value;
+
+	for(it = line_start(it, eol); next_number(it, eol, value); )
+		values.push_back(value);
+
+	return line_start(it, eol) == eol;
+}
+
+void count_points(Chunk &chunk){
+	for(const char *it = chunk.begin, *eol; it != chunk.end; it = next_line(eol, chunk.end)){
+		eol = end_of_line(it, chunk.end);
+		chunk.points += line_start(it, eol) != eol;
+	}
+}
+
+// parses the points of a chunk into their place of the point block, normalized as they are read
+void parse_points(Chunk &chunk, const std::vector<double> &ref, Problem *P){
+	double *dest = P->X->values + chunk.first * P->dim;
+
+	for(const char *it = chunk.begin, *eol; it != chunk.end; it = next_line(eol, chunk.end)){
+		eol = end_of_line(it, chunk.end);
+		it = line_start(it, eol);
+
+		if(it == eol)
+			continue;
+
+		double value;
+		int j = 0;
+
+		for(; j < P->dim && next_number(it, eol, value); ++j)
+			chunk.dominated = normalize(value, ref[j], *dest++, P) && chunk.dominated;
+
+		if(j < P->dim || next_number(it, eol, value)){
+			chunk.same_dimension = false;
+			return;
+		}
+	}
+}
+
+// maps a regular file into memory. anything else, like a pipe, can not be mapped
+const char *map_file(const std::string &path, size_t &size){
+	struct stat st;
+	const int fd = open(path.c_str(), O_RDONLY);
+
+	if(fd < 0)
+		return nullptr;
+	if(fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size == 0){
+		close(fd);
+		return nullptr;
+	}
+
+	size = st.st_size;
+	void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(map == MAP_FAILED)
+		return nullptr;
+
+	madvise(map, size, MADV_SEQUENTIAL);
+	return (const char *) map;
+}
+
+// number of coordinates of the first point
+int first_dimension(const char *begin, const char *end){
+	const char *it = begin, *eol = begin;
+	double value;
+	int dim = 0;
+
+	for(; it != end; it = next_line(eol, end)){
+		eol = end_of_line(it, end);
+		it = line_start(it, eol);
+
+		if(it != eol)
+			break;
+	}
+
+	while(it != end && next_number(it, eol, value))
+		dim++;
+
+	return dim;
+}
+
+// parses the points of a mapped file. large files are split in chunks at line boundaries that are
+// counted and then parsed in parallel, so each chunk knows where its points go
+bool parse_mapped(const char *begin, const char *end, int dim, std::vector<double> &ref, Problem *P){
+	const long int size = end - begin, min_chunk = 1l << 20;
+	const int nchunks = std::max(1, (int) std::min<long int>(P->cores, size / min_chunk));
+	std::vector<Chunk> chunks(nchunks);
+	std::vector<std::thread> threads;
+
+	P->dim = dim;
+	if(ref.size() && (size_t) dim != ref.size())
+		return ERROR(P, "invalid input data point or reference point dimension\n");
+
+	for(int c = 0; c < nchunks; ++c){
+		chunks[c].begin = c == 0 ? begin : chunks[c-1].end;
+		chunks[c].end = c == nchunks - 1 ? end : next_line(end_of_line(begin + size / nchunks * (c + 1), end), end);
+	}
+
+	for(Chunk &chunk : chunks)
+		threads.push_back(std::thread(count_points, std::ref(chunk)));
+	for(std::thread &t : threads)
+		t.join();
+
+	for(Chunk &chunk : chunks){
+		chunk.first = P->n;
+		P->n += chunk.points;
+	}
+
+	ref.resize(P->dim, 0.0);
+	P->ref = new double[P->dim]();
+	P->X = new_points(P->n, P->dim, true);
+	threads.clear();
+
+	for(Chunk &chunk : chunks)
+		threads.push_back(std::thread(parse_points, std::ref(chunk), std::cref(ref), P));
+	for(std::thread &t : threads)
+		t.join();
+
+	for(const Chunk &chunk : chunks)
+		if(!chunk.same_dimension)
+			return ERROR(P, "input data points must have the same dimension\n");
+
+	if(!check_size(P))
+		return false;
+
+	for(const Chunk &chunk : chunks)
+		if(!chunk.dominated)
+			return ERROR(P, "reference point must dominate input data points\n");
+
+	P->solution = new_points(P->n, P->dim, false);
+	P->initialized = true;
+	return true;
+}
+
+// offset of the coordinates of a binary instance of the given dimension
+size_t binary_offset(int dim){
+	const size_t offset = sizeof(BinaryHeader) + sizeof(double) * dim;
+	return (offset + 63) / 64 * 64;
+}
+
+bool is_binary(const char *map, size_t size){
+	return size >= sizeof(BinaryHeader) && !memcmp(map, binary_magic__, sizeof(binary_magic__));
+}
+
+// uses the coordinates of a mapped binary instance in place. they are normalized already, so the
+// reference point and the orientation given in the command line can only repeat those of the header
+bool load_binary(const char *map, size_t size, std::vector<double> &ref, Problem *P){
+	BinaryHeader header;
+	memcpy(&header, map, sizeof(header));
+
+	// the mapping is kept until the problem is cleared
+	P->mapped = (void *) map;
+	P->mapped_size = size;
+	madvise(P->mapped, size, MADV_WILLNEED);
+
+	if(header.n <= 0 || header.dim <= 0 || size < binary_offset(header.dim) + sizeof(double) * header.n * header.dim)
+		return ERROR(P, "invalid binary input file\n");
+
+	const double *original_ref = (const double *) (map + sizeof(BinaryHeader));
+
+	if(ref.size() && !std::equal(ref.begin(), ref.end(), original_ref, original_ref + header.dim))
+		return ERROR(P, "reference point does not match the binary input file\n");
+	if(P->maximize && !header.maximize)
+		return ERROR(P, "binary input file was written for a minimization problem\n");
+
+	P->n = header.n;
+	P->dim = header.dim;
+	P->maximize = header.maximize;
+	ref.assign(original_ref, original_ref + header.dim);
+
+	if(!check_size(P))
+		return false;
+
+	P->ref = new double[P->dim]();
+	P->X = new_points(P->n, P->dim, false);
+	P->solution = new_points(P->n, P->dim, false);
+
+	double *values = (double *) (map + binary_offset(P->dim));
+
+	for(int i = 0; i < P->n; ++i)
+		P->X[i].values = values + i * P->dim;
+
+	for(const double *it = values; it != values + P->n * P->dim; ++it)
+		if(!(*it < 0))
+			return ERROR(P, "reference point must dominate input data points\n");
+
+	P->initialized = true;
+	return true;
+}
+
+// writes the normalized points with the original reference point and orientation, so a later solve
+// of the same points maps them without parsing
+bool write_binary(const std::string &path, const std::vector<double> &ref, Problem *P){
+	BinaryHeader header {};
+	const std::vector<char> padding(binary_offset(P->dim) - sizeof(header) - sizeof(double) * P->dim, 0);
+	std::ofstream file(path, std::ofstream::binary | std::ofstream::trunc);
+
+	memcpy(header.magic, binary_magic__, sizeof(binary_magic__));
+	header.n = P->n;
+	header.dim = P->dim;
+	header.maximize = P->maximize;
+
+	file.write((const char *) &header, sizeof(header));
+	file.write((const char *) ref.data(), sizeof(double) * P->dim);
+	file.write(padding.data(), padding.size());
+	file.write((const char *) P->X->values, sizeof(double) * P->n * P->dim);
+	file.close();
+
+	if(!file.good())
+		return ERROR(P, "failed to write binary file '" + path + "'\n");
+
+	return true;
+}
+
+// reads the points of the input file without copies. the stream parser is used for the files that
+// can not be mapped and for those whose first point has no coordinates
+bool read_points(const std::string &path, std::ifstream &file, std::vector<double> &ref, Problem *P){
+	size_t size;
+	const char *map = map_file(path, size);
+
+	if(map && is_binary(map, size)){
+		file.close();
+		return load_binary(map, size, ref, P);
+	}
+
+	const int dim = map ? first_dimension(map, map + size) : 0;
+
+	if(dim == 0){
+		if(map)
+			munmap((void *) map, size);
+
+		return read_input(file, ref, P);
+	}
+
+	file.close();
+	const bool okay = parse_mapped(map, map + size, dim, ref, P);
+	munmap((void *) map, size);
+	return okay;
+}
@@ -0,0 +1,23 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include "util.h"
+
+#include <string>       // string
+#include <vector>       // vector
+#include <fstream>      // ifstream, ofstream
+#include <thread>       // thread
+#include <charconv>     // from_chars
+#include <cstring>      // memchr, memcmp, memcpy
+#include <cctype>       // isdigit
+#include <cstdint>      // int32_t
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#include <sys/mman.h>   // mmap, munmap, madvise
+#include <sys/stat.h>   // fstat
+
+bool parse_line(const std::string & , std::vector<double> & );
+bool write_binary(const std::string & , const std::vector<double> & , Problem * );
+bool read_points(const std::string & , std::ifstream & , std::vector<double> & , Problem * );
+
+#endif
@@ -0,0 +1,111 @@
+#include "solver.h"
+#include "hssp.h"
+#include "warm.h"
+
+// sets up the problem of the given points with the options of a solve. fails with the error in P
+bool init_solve(const std::vector<std::vector<double> > &points, const std::vector<double> &ref, const SolveOptions &options, Problem *P){
+	std::vector<double> values, reference(ref);
+
+	init_problem(P);
+	P->silent = true;
+	P->k = options.k;
+	P->kset = options.k != 0;
+	P->cores = options.cores;
+	P->split = options.split;
+	P->split_cutoff = options.split_cutoff;
+	P->affinity = options.affinity;
+	P->maximize = options.maximize;
+	P->deterministic = options.deterministic;
+	P->pingmode = options.ping;
+	P->cancel = options.cancel;
+
+	if(options.portfolio)
+		P->portfolio = portfolio_configs;
+
+	if(options.progress){
+		P->progress = [&options](Problem *problem, const std::string &type){
+			const duration<double> elapsed = high_resolution_clock::now() - problem->t0;
+
+			// a ping comes from any worker without the solution lock, while others may write a new best
+			// subset. it only reports the hypervolume of the best subset, read under the lock
+			if(type == "ping"){
+				std::unique_lock<std::mutex> ul(problem->solution_mtx);
+				const double best = problem->best;
+				ul.unlock();
+
+				options.progress({type, best, total(problem, &ThreadStats::nodes), elapsed.count(), {}});
+				return;
+			}
+
+			options.progress({type, problem->best, total(problem, &ThreadStats::nodes), elapsed.count(), solution_to_vector(problem)});
+		};
+	}
+
+	for(const std::vector<double> &point : points){
+		if(point.size() != points[0].size() || (!ref.empty() && point.size() != ref.size()))
+			return ERROR(P, "invalid input data point or reference point dimension\n");
+
+		values.insert(values.end(), point.begin(), point.end());
+	}
+
+	P->dim = points.empty() ? 0 : (int) points[0].size();
+
+	if(!check_options(P) || !load_points(values, reference, P))
+		return false;
+
+	return !options.warm || init_warm_start(*options.warm, reference, P);
+}
+
+// solves the problem of the given points in memory. each solve has its own state, so several of them
+// may run at the same time
+SolveResult solve(const std::vector<std::vector<double> > &points, const std::vector<double> &ref, SolveOptions options){
+	Problem P {};
+	SolveResult result {-1, {}, 0, false, "", {}};
+
+	if(!init_solve(points, ref, options, &P)){
+		result.error = P.error;
+		return result;
+	}
+
+	result.volume = solve_problem(&P, nullptr);
+	result.solution = solution_to_vector(&P);
+	result.nodes = total(&P, &ThreadStats::nodes);
+	result.optimal = !P.stopped;
+	result.contributions = P.contributions;
+	clear_memory(&P);
+	return result;
+}
+
+// solves every subset size from 1 to options.k, or to the number of points when it is 0. the sizes are
+// searched on options.cores threads, one size per thread, and the result of size k is at k-1. the
+// progress callback is only called once for each size, with its final result
+std::vector<SolveResult> solve_all_k(const std::vector<std::vector<double> > &points, const std::vector<double> &ref, SolveOptions options){
+	Problem P {};
+	std::vector<SolveResult> results;
+	std::function<void(const SolveProgress &)> progress = options.progress;
+
+	options.progress = nullptr;
+	P.all_k = true;
+
+	if(!init_solve(points, ref, options, &P)){
+		results.push_back({-1, {}, 0, false, P.error, {}});
+		return results;
+	}
+
+	sweep(options.k ? options.k : P.n, [&](Problem *Q){
+		const duration<double> elapsed = high_resolution_clock::now() - P.t0;
+		const long int nodes = total(Q, &ThreadStats::nodes);
+
+		results.push_back({Q->best, solution_to_vector(Q), nodes, !Q->stopped, "", {}});
+		if(progress)
+			progress({Q->stopped ? "stop" : "end", Q->best, nodes, elapsed.count(), results.back().solution});
+	}, &P);
+
+	clear_memory(&P);
+	return results;
+}
+
+// starts a solve on its own thread. the points are copied, so the caller may change them meanwhile
+std::future<SolveResult> solve_async(std::vector<std::vector<double> > points, std::vector<double> ref, SolveOptions options){
+	return std::async(std::launch::async, solve, std::move(points), std::move(ref), std::move(options));
+}
@@ -0,0 +1,61 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "util.h"
+
+#include <vector>     // vector
+#include <string>     // string
+#include <functional> // function
+#include <future>     // future, async
+
+// state of a solve given to the progress callback. the callback of a new best solution runs with the
+// solution lock held, so it should return quickly. the reports of type init, new, end and stop have
+// the best subset, consistent with its hypervolume, and a ping only has the hypervolume, since it is
+// reported by any worker while the others search
+struct SolveProgress {
+	std::string type;          // init, new, ping, end or stop
+	double best;               // hypervolume of the best subset found so far
+	long int nodes;
+	double time;               // seconds since the solve started
+	std::vector<int> solution; // one flag per point for the best subset found so far, empty for a ping
+};
+
+// previous solve of an archive that changed by a few points since. its subset is given by the indices
+// of the points in the current archive, by their coordinates, or both, and the points no longer in the
+// archive are dropped from it. the contributions of the previous result are given by index in the
+// current archive, and with them the points added since by index and the points removed since by
+// their coordinates. the contributions the changes can not affect are not computed again
+struct WarmStart {
+	std::vector<int> subset, added;
+	std::vector<std::vector<double> > subset_points, removed;
+	std::vector<double> contributions;
+};
+
+// options of a solve given in memory. they match the options of the command line
+struct SolveOptions {
+	int k = 0;                 // half of the points when it is 0
+	int cores = 1;
+	int split_cutoff = 8;
+	Split split = SPLIT_IDLE;
+	Affinity affinity = AFFINITY_NONE;
+	bool maximize = false, deterministic = false, portfolio = false;
+	bool ping = false;         // also report the progress at growing intervals without new solutions
+	CancelToken *cancel = nullptr;
+	const WarmStart *warm = nullptr;
+	std::function<void(const SolveProgress &)> progress;
+};
+
+struct SolveResult {
+	double volume;
+	std::vector<int> solution; // one flag per point, as printed by the command line
+	long int nodes;
+	bool optimal;              // false when the solve was cancelled
+	std::string error;         // why the options or the points were rejected
+	std::vector<double> contributions; // root exclusive contributions of the points, for a warm start
+};
+
+SolveResult solve(const std::vector<std::vector<double> > & , const std::vector<double> & , SolveOptions );
+std::vector<SolveResult> solve_all_k(const std::vector<std::vector<double> > & , const std::vector<double> & , SolveOptions );
+std::future<SolveResult> solve_async(std::vector<std::vector<double> > , std::vector<double> , SolveOptions );
+
+#endif
@@ -70,57 +70,1467 @@ std::vector<std::vector<int> > load_positions(File file){
 	}
 }
 
-void run_validation_tests(){
+// solves a case in a child process, which its alarm terminates after the timeout. the child writes
+// the volume, the time, the nodes and the size of the solution to the pipe, and then the solution
+void start_case(ValidationCase &c, int timeout){
+	int fds[2];
+	if(pipe(fds)){
+		c.error = "failed to create a pipe";
+		return;
+	}
+
+	fflush(stdout);
+	c.pid = fork();
+
+	if(c.pid == 0){
+		std::vector<std::string> args {"-k", std::to_string(c.k), c.file->path + c.file->name, "-r", c.file->ref, "-j", std::to_string(c.cores)};
+		std::vector<int> solution;
+		long int nodes = 0;
+
+		if(c.file->problem_type.size())
+			args.push_back(c.file->problem_type);
+
+		close(fds[0]);
+		alarm(timeout);
+
+		const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		const double volume = hssp(args, solution, nodes);
+		const duration<double> elapsed = high_resolution_clock::now() - t0;
+
+		const double header[4] = {volume, elapsed.count(), (double) nodes, (double) solution.size()};
+		const ssize_t size = solution.size() * sizeof(int);
+		_exit(write(fds[1], header, sizeof(header)) == sizeof(header) && write(fds[1], solution.data(), size) == size ? 0 : 1);
+	}
+
+	close(fds[1]);
+	c.fd = fds[0];
+
+	if(c.pid < 0){
+		close(c.fd);
+		c.error = "failed to fork";
+	}
+}
+
+// reads the result of a case whose process ended
+void finish_case(ValidationCase &c, int status){
+	double header[4];
+
+	if(WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM)
+		c.error = "timeout";
+	else if(!WIFEXITED(status) || WEXITSTATUS(status) != 0 || read(c.fd, header, sizeof(header)) != sizeof(header))
+		c.error = "crashed";
+	else {
+		c.volume = header[0];
+		c.time = header[1];
+		c.nodes = header[2];
+		c.solution.resize(header[3]);
+
+		const ssize_t size = c.solution.size() * sizeof(int);
+		if(read(c.fd, c.solution.data(), size) != size)
+			c.error = "crashed";
+	}
+
+	close(c.fd);
+}
+
+// solves every file with an output and every subset size with several numbers of workers, each case
+// in its own process and as many cases at a time as there are cpus. the results are compared with the
+// outputs, and the files without one, given with '--all', are compared across the numbers of workers.
+// '--filter' keeps the files whose name contains the text, and '--shard I/N' keeps the I-th of every
+// N subset sizes of the files, counted from 1, so that the shards split the validation among machines
+bool run_validation_tests(std::vector<std::string> args){
+	std::string filter, cores_list = "1,2,4";
+	int jobs = std::max(1u, std::thread::hardware_concurrency()), timeout = 120, shard = 1, shards = 1, only_k = 0;
+	bool all = false;
+	int fails = 0, timeouts = 0;
 	long int total_nodes = 0;
-	const int max_repetitions = 1;
 
-	for(File file : test_files){
-		std::string path_to_file = file.path + file.name;
-		std::vector<double> volumes = load_outputs(file);
-		std::vector<std::vector<int> > positions = load_positions(file);
+	for(std::vector<std::string>::iterator it = args.begin(); it != args.end(); ++it){
+		const bool last = std::next(it) == args.end();
+		bool invalid = false;
 
-		// if(volumes.empty()) continue;
+		if(*it == "--filter" && !last)
+			filter = *++it;
+		else if(*it == "-k" && !last)
+			invalid = stoi__(&only_k, *++it) || only_k < 1;
+		else if(*it == "--cores" && !last)
+			cores_list = *++it;
+		else if(*it == "--jobs" && !last)
+			invalid = stoi__(&jobs, *++it) || jobs < 1;
+		else if(*it == "--timeout" && !last)
+			invalid = stoi__(&timeout, *++it) || timeout < 1;
+		else if(*it == "--shard" && !last){
+			const std::string value = *++it;
+			const size_t slash = value.find('/');
+			invalid = slash == std::string::npos || stoi__(&shard, value.substr(0, slash)) || stoi__(&shards, value.substr(slash + 1)) || shards < 1 || shard < 1 || shard > shards;
+		}
+		else if(*it == "--all")
+			all = true;
+		else if(*it != "--test")
+			invalid = true;
+
+		if(invalid){
+			logger::fail("usage: hssp-test [--filter TEXT] [-k K] [--cores 1,2,4] [--jobs N] [--timeout S] [--shard I/N] [--all]");
+			return false;
+		}
+	}
 
-		for(int k = 1; k <= file.size; ++k){
-			std::vector<std::string> args{"-k", std::to_string(k), path_to_file, "-r", file.ref, "-j", "4"};
+	std::vector<int> cores;
+	std::istringstream iss(cores_list);
 
-			if(file.problem_type.size())
-				args.push_back(file.problem_type);
+	for(std::string value; std::getline(iss, value, ',');){
+		int c;
+		if(stoi__(&c, value) || c < 1){
+			logger::fail("invalid number of workers '" + value + "'");
+			return false;
+		}
 
-			for(int repeat = 1; repeat <= max_repetitions; ++repeat){
+		cores.push_back(c);
+	}
+
+	// the cases of one file and subset size are next to each other, so they can be compared
+	std::vector<ValidationCase> cases;
+	std::map<const File *, std::pair<std::vector<double>, std::vector<std::vector<int> > > > outputs;
+	int index = 0;
+
+	for(const File &file : test_files){
+		if((file.output_type == 0 && !all) || file.name.find(filter) == std::string::npos)
+			continue;
+
+		outputs[&file] = std::make_pair(load_outputs(file), load_positions(file));
+
+		for(int k = 1; k <= file.size; ++k)
+			if((only_k == 0 || k == only_k) && index++ % shards == shard - 1)
+				for(int c : cores)
+					cases.push_back({&file, k, c, -1, -1, 0.0, 0.0, 0, {}, ""});
+	}
+
+	const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	std::map<pid_t, ValidationCase *> running;
+	size_t next = 0;
+
+	while(next < cases.size() || !running.empty()){
+		while(next < cases.size() && (int) running.size() < jobs){
+			ValidationCase &c = cases[next++];
+			start_case(c, timeout);
+
+			if(c.pid > 0)
+				running[c.pid] = &c;
+			else {
+				logger::fail("file " + c.file->name + " k " + std::to_string(c.k) + " j " + std::to_string(c.cores) + " " + c.error);
+				fails++;
+			}
+		}
+
+		int status = 0;
+		const pid_t pid = waitpid(-1, &status, 0);
+		if(pid <= 0 && running.empty())
+			continue;
+		if(pid <= 0)
+			break;
+
+		const auto it = running.find(pid);
+		if(it == running.end())
+			continue;
+
+		ValidationCase &c = *it->second;
+		running.erase(it);
+		finish_case(c, status);
+
+		const std::vector<double> &volumes = outputs[c.file].first;
+		const std::vector<std::vector<int> > &positions = outputs[c.file].second;
+		const bool expected = (int) volumes.size() >= c.k && (int) positions.size() >= c.k;
+
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(6) << "got " << c.volume << " expected " << (expected ? volumes[c.k-1] : 0.0) << " file " << c.file->name << " nodes " << c.nodes << " time " << c.time << "s" << " k " << c.k << " j " << c.cores;
+
+		if(!c.error.empty()){
+			logger::fail(ss.str() + " " + c.error);
+			timeouts += c.error == "timeout";
+			fails++;
+		}
+		else if(!expected)
+			logger::warn(ss.str());
+		else if(eq__(c.volume, volumes[c.k-1]) && c.solution == positions[c.k-1])
+			logger::okay(ss.str());
+		else {
+			logger::fail(ss.str());
+			fails++;
+		}
+
+		total_nodes += c.nodes;
+	}
+
+	// every number of workers finds the same volume as the first one
+	for(size_t i = 1; i < cases.size(); ++i){
+		const ValidationCase &a = cases[i-1], &b = cases[i];
+		if(a.file != b.file || a.k != b.k || !a.error.empty() || !b.error.empty() || eq__(a.volume, b.volume))
+			continue;
+
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(6) << "file " << b.file->name << " k " << b.k << " got " << a.volume << " with j " << a.cores << " and " << b.volume << " with j " << b.cores;
+		logger::fail(ss.str());
+		fails++;
+	}
+
+	const duration<double> elapsed = high_resolution_clock::now() - t0;
+	std::stringstream ss;
+	ss << std::fixed << std::setprecision(1) << "validation cases " << cases.size() << " fails " << fails << " timeouts " << timeouts << " total nodes " << total_nodes << " time " << elapsed.count() << "s";
+	logger::info(ss.str());
+
+	return fails == 0;
+}
+
+// logs the result of a case of a suite and counts it when it failed
+void log_case(bool okay, const std::string &msg, int &fails){
+	if(okay)
+		logger::okay(msg);
+	else
+		logger::fail(msg);
+
+	fails += !okay;
+}
+
+// logs the fails of a suite, which passes without any
+bool suite_result(const std::string &suite, int fails){
+	logger::info(suite + " fails " + std::to_string(fails));
+	return fails == 0;
+}
+
+// solves the cases of a suite on the small validation files and compares them with the outputs.
+// returns the number of cases that failed
+int run_file_cases(const FileCases &cases, CaseSolve solve){
+	std::mt19937 rng(7);
+	int fails = 0;
+
+	for(const File &file : test_files){
+		if(file.output_type != 1 || file.size < cases.min_size || file.size > cases.max_size)
+			continue;
+
+		const std::vector<double> volumes = load_outputs(file);
+		const std::vector<std::vector<int> > positions = load_positions(file);
+
+		for(int repeat = 0; repeat < cases.repeats; ++repeat){
+			const int k = cases.central_k ? std::uniform_int_distribution<int>(file.size / 3, 2 * file.size / 3)(rng) : std::uniform_int_distribution<int>(2, file.size - 2)(rng);
+
+			for(const std::string &variant : cases.variants){
+				const CaseResult result = solve(file, k, variant, rng);
+				const double expected = volumes[k-1];
+				bool okay = result.okay && (result.stopped ? result.volume <= expected || eq__(result.volume, expected) : eq__(result.volume, expected));
+				okay = okay && (result.solution.empty() || result.solution == positions[k-1]);
+
+				std::stringstream ss;
+				ss << std::fixed << std::setprecision(6) << "got " << result.volume << " expected " << expected << " file " << file.name << " k " << k << result.details;
+				log_case(okay, ss.str(), fails);
+			}
+		}
+	}
+
+	return fails;
+}
+
+// stops the search at a random node, saves it and compares the result of the resumed search
+bool run_checkpoint_tests(){
+	const std::string checkpoint_file = "test.checkpoint";
+	FileCases cases {"checkpoint"};
+	cases.variants = {"1", "3"};
+
+	const int fails = run_file_cases(cases, [&](const File &file, int k, const std::string &cores, std::mt19937 &rng){
+		std::vector<std::string> args{"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "-j", cores};
+		long int nodes;
+		std::vector<int> solution;
+
+		hssp(args, solution, nodes);
+		const long int stop = std::uniform_int_distribution<long int>(1, nodes)(rng);
+
+		std::vector<std::string> stop_args(args);
+		stop_args.insert(stop_args.end(), {"--checkpoint", checkpoint_file, "--stop-after", std::to_string(stop)});
+		std::remove(checkpoint_file.c_str());
+		double got_volume = hssp(stop_args, solution, nodes);
+
+		// the search may end before the stop point with more than one thread
+		if(std::ifstream(checkpoint_file).good()){
+			std::vector<std::string> resume_args(args);
+			resume_args.insert(resume_args.end(), {"--resume", checkpoint_file});
+			got_volume = hssp(resume_args, solution, nodes);
+		}
+
+		return CaseResult {got_volume, solution, true, false, " j " + cores + " stop " + std::to_string(stop)};
+	});
+
+	std::remove(checkpoint_file.c_str());
+	return suite_result("checkpoint", fails);
+}
+
+// runs the coordinator with two local worker processes and compares the results
+bool run_distributed_tests(){
+	const std::string address = "unix:test.socket";
+	FileCases cases {"distributed"};
+	cases.repeats = 2;
+	int fails = 0;
+
+	// a message goes through the framing, and a header with a size above the limit ends the stream
+	// before the payload is allocated
+	int fds[2];
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0){
+		Channel sender(fds[0]), receiver(fds[1]);
+		MessageType type;
+		std::string payload;
+		const bool framed = sender.send(MSG_DONE, "payload") && receiver.receive(type, payload) && type == MSG_DONE && payload == "payload";
+
+		char header[sizeof(int32_t) + sizeof(int64_t)];
+		const int32_t t = little_endian__((int32_t) MSG_TASK);
+		const int64_t size = little_endian__(max_message_size__ + 1);
+		std::memcpy(header, &t, sizeof(t));
+		std::memcpy(header + sizeof(t), &size, sizeof(size));
+		const bool rejected = write(fds[0], header, sizeof(header)) == (ssize_t) sizeof(header) && !receiver.receive(type, payload);
+
+		log_case(framed && rejected, "distributed framing", fails);
+	}
+	else{
+		log_case(false, "distributed framing socketpair", fails);
+	}
+
+	fails += run_file_cases(cases, [&](const File &file, int k, const std::string & , std::mt19937 & ){
+		std::vector<pid_t> workers;
+
+		fflush(stdout);
+
+		for(int w = 0; w < 2; ++w){
+			const pid_t pid = fork();
+
+			if(pid == 0){
 				long int nodes;
 				std::vector<int> solution;
+				hssp({"--worker", address, "-j", std::to_string(w + 1)}, solution, nodes);
+				_exit(0);
+			}
+
+			workers.push_back(pid);
+		}
+
+		long int nodes;
+		std::vector<int> solution;
+		const double got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "-j", "2", "--serve-workers", address}, solution, nodes);
+
+		for(pid_t pid : workers)
+			waitpid(pid, nullptr, 0);
+
+		return CaseResult {got_volume, solution, true, false, " nodes " + std::to_string(nodes)};
+	});
+
+	return suite_result("distributed", fails);
+}
+
+// runs the deterministic search with different numbers of threads and compares the explored nodes
+bool run_deterministic_tests(){
+	int fails = run_file_cases({"deterministic"}, [](const File &file, int k, const std::string & , std::mt19937 & ){
+		CaseResult result {-1, {}, true, false, " nodes"};
+		long int first_nodes = -1;
+
+		for(std::string cores : {"1", "2", "4"}){
+			long int nodes;
+			std::vector<int> solution;
+			const double got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "-j", cores, "--deterministic"}, solution, nodes);
+
+			// every number of threads finds the subset of one thread with as many nodes
+			if(first_nodes < 0){
+				result.volume = got_volume;
+				result.solution = solution;
+				first_nodes = nodes;
+			}
+
+			result.okay = result.okay && eq__(got_volume, result.volume) && solution == result.solution && nodes == first_nodes;
+			result.details += " " + std::to_string(nodes);
+		}
+
+		return result;
+	});
+
+	// a cancel stops the tasks that wait at their sync points for the earlier tasks of their epoch
+	for(int delay : {0, 20, 100}){
+		CancelToken token;
+		long int nodes;
+		bool stopped;
+		std::vector<int> solution;
+
+		std::thread search([&]{
+			hssp({"-k", "20", "test/validation/convex.1s.3d.70.dat", "-r", "1 1 1", "-j", "4", "--deterministic"}, solution, nodes, &token, &stopped);
+		});
+
+		std::this_thread::sleep_for(milliseconds(delay));
+		token.cancel();
+		search.join();
+
+		const bool okay = std::count(solution.begin(), solution.end(), 1) == 20;
+		log_case(okay, "cancel after " + std::to_string(delay) + "ms nodes " + std::to_string(nodes) + " stopped " + std::to_string(stopped), fails);
+	}
+
+	return suite_result("deterministic", fails);
+}
+
+// cancels searches from another thread and checks that they stop with a valid subset that is not
+// better than the optimal one
+bool run_cancel_tests(){
+	FileCases cases {"cancel"};
+	cases.repeats = 2;
+	cases.min_size = 30;
+	cases.max_size = 100;
+	cases.central_k = true;
+	cases.variants = {"1", "3"};
+
+	const int fails = run_file_cases(cases, [](const File &file, int k, const std::string &cores, std::mt19937 &rng){
+		CancelToken token;
+		long int nodes;
+		bool stopped;
+		std::vector<int> solution;
+		double got_volume;
+
+		std::thread search([&]{
+			got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "-j", cores}, solution, nodes, &token, &stopped);
+		});
+
+		std::this_thread::sleep_for(milliseconds(std::uniform_int_distribution<int>(0, 20)(rng)));
+		token.cancel();
+		search.join();
+
+		// a search may end before it is cancelled
+		const bool valid = std::count(solution.begin(), solution.end(), 1) == k;
+		return CaseResult {got_volume, {}, valid, stopped, " j " + cores + " nodes " + std::to_string(nodes) + " stopped " + std::to_string(stopped)};
+	});
+
+	return suite_result("cancel", fails);
+}
+
+std::vector<std::vector<double> > read_points_file(std::string path_to_points){
+	std::ifstream file(path_to_points);
+	std::vector<std::vector<double> > points;
+	std::string line;
+
+	while(std::getline(file, line)){
+		if(is_comment(line))
+			continue;
+
+		std::istringstream iss(line);
+		points.push_back(std::vector<double>(std::istream_iterator<double>(iss), std::istream_iterator<double>()));
+	}
+
+	return points;
+}
+
+// runs several solves of points in memory at the same time and checks their results and the order of
+// their progress reports
+bool run_solver_tests(){
+	int fails = run_file_cases({"solver"}, [](const File &file, int k, const std::string & , std::mt19937 & ){
+		const std::vector<std::vector<double> > points = read_points_file(file.path + file.name);
+		std::vector<std::future<SolveResult> > results;
+		std::vector<SolveProgress> reports[2];
+		CaseResult result {-1, {}, true, false, " reports"};
+
+		for(int s = 0; s < 2; ++s){
+			SolveOptions options;
+			options.k = k;
+			options.cores = 1 + s;
+			options.progress = [&reports, s](const SolveProgress &progress){ reports[s].push_back(progress); };
+
+			results.push_back(solve_async(points, {1.0, 1.0, 1.0}, options));
+		}
+
+		for(int s = 0; s < 2; ++s){
+			const SolveResult solved = results[s].get();
+			const std::vector<SolveProgress> &report = reports[s];
+
+			if(s == 0){
+				result.volume = solved.volume;
+				result.solution = solved.solution;
+			}
+
+			result.okay = result.okay && solved.error.empty() && solved.optimal && eq__(solved.volume, result.volume) && solved.solution == result.solution;
+			result.okay = result.okay && !report.empty() && report.back().type == "end" && report.back().solution == solved.solution;
+
+			for(int r = 1; r < (int) report.size(); ++r)
+				result.okay = result.okay && report[r-1].best <= report[r].best;
+
+			result.details += " " + std::to_string(report.size());
+		}
+
+		return result;
+	});
+
+	// every subset size of a file is solved at once
+	for(File file : test_files){
+		if(file.output_type != 1 || file.size > 30)
+			continue;
+
+		SolveOptions options;
+		options.cores = 2;
+
+		const std::vector<SolveResult> all = solve_all_k(read_points_file(file.path + file.name), {1.0, 1.0, 1.0}, options);
+		const std::vector<double> file_volumes = load_outputs(file);
+		const std::vector<std::vector<int> > file_positions = load_positions(file);
+		bool okay = (int) all.size() == file.size;
+
+		for(int k = 1; okay && k <= file.size; ++k)
+			okay = all[k-1].optimal && eq__(all[k-1].volume, file_volumes[k-1]) && all[k-1].solution == file_positions[k-1];
+
+		log_case(okay, "all sizes of file " + file.name, fails);
+	}
+
+	// invalid problems are reported instead of solved
+	SolveOptions options;
+	options.k = 5;
+	const SolveResult invalid = solve({{0.5, 0.5, 0.5}, {0.2, 0.7, 0.1}}, {1.0, 1.0, 1.0}, options);
+	options.k = 1;
+	const SolveResult undominated = solve({{0.5, 0.5, 0.5}, {0.2, 1.7, 0.1}}, {1.0, 1.0, 1.0}, options);
+
+	if(invalid.error.empty() || undominated.error.empty()){
+		logger::fail("invalid problems were solved");
+		fails++;
+	}
+
+	return suite_result("solver", fails);
+}
+
+// writes each file as a binary instance and compares the results of the solves of both files
+bool run_binary_tests(){
+	const std::string binary_file = "test.bin";
+
+	int fails = run_file_cases({"binary"}, [&](const File &file, int k, const std::string & , std::mt19937 & ){
+		const std::string path_to_file = file.path + file.name;
+		long int nodes, binary_nodes;
+		std::vector<int> solution;
+
+		std::remove(binary_file.c_str());
+		hssp({path_to_file, "-r", file.ref, "--write-binary", binary_file}, solution, nodes);
+
+		hssp({"-k", std::to_string(k), path_to_file, "-r", file.ref}, solution, nodes);
+		const double got_volume = hssp({"-k", std::to_string(k), binary_file}, solution, binary_nodes);
+
+		return CaseResult {got_volume, solution, nodes == binary_nodes, false, " nodes " + std::to_string(binary_nodes)};
+	});
+
+	// the reference point of a binary instance can not be changed
+	long int nodes;
+	std::vector<int> solution;
+	if(hssp({"-k", "2", binary_file, "-r", "2 2 2"}, solution, nodes) >= 0){
+		logger::fail("binary instance solved with another reference point");
+		fails++;
+	}
+
+	std::remove(binary_file.c_str());
+	return suite_result("binary", fails);
+}
+
+// solves the files on a daemon process over one connection and compares the results. a request with
+// a short deadline returns before the search ends
+bool run_daemon_tests(){
+	const std::string address = "unix:test.socket";
+	int fails = 0;
+
+	fflush(stdout);
+	const pid_t pid = fork();
+
+	if(pid == 0){
+		long int nodes;
+		std::vector<int> solution;
+		hssp({"--daemon", address, "-j", "2"}, solution, nodes);
+		_exit(0);
+	}
+
+	Channel *ch = connect_to(address, 10.0);
+	FileCases cases {"daemon"};
+	cases.repeats = 2;
+
+	if(ch)
+		fails += run_file_cases(cases, [ch](const File &file, int k, const std::string & , std::mt19937 & ){
+			SolveOptions options;
+			int reports = 0;
+
+			options.k = k;
+			options.progress = [&reports](const SolveProgress & ){ reports++; };
+
+			const SolveResult result = request_solve(ch, read_points_file(file.path + file.name), {1.0, 1.0, 1.0}, options, 0.0);
+			return CaseResult {result.volume, result.solution, result.error.empty() && result.optimal && reports > 0, false, " reports " + std::to_string(reports)};
+		});
+
+	SolveOptions options;
+	options.k = 30;
+	const SolveResult timed = ch ? request_solve(ch, read_points_file("test/validation/concave.1s.3d.70.dat"), {1.0, 1.0, 1.0}, options, 0.05) : SolveResult {};
+	options.k = 5;
+	const SolveResult invalid = ch ? request_solve(ch, {{0.5, 0.5, 0.5}, {0.2, 0.7, 0.1}}, {1.0, 1.0, 1.0}, options, 0.0) : SolveResult {};
+
+	if(!ch || !timed.error.empty() || timed.optimal || timed.volume <= 0){
+		logger::fail("request with a deadline was not stopped");
+		fails++;
+	}
+	if(!ch || invalid.error.empty()){
+		logger::fail("invalid request was solved");
+		fails++;
+	}
+
+	delete ch;
+	kill(pid, SIGTERM);
+	waitpid(pid, nullptr, 0);
+	std::remove("test.socket");
+	return suite_result("daemon", fails);
+}
+
+// solves the files with a profile and checks that its depths add up to the nodes of the search, and
+// that the branches of the root hold every other node
+bool run_profile_tests(){
+	const std::string profile_file = "test.profile";
+	FileCases cases {"profile"};
+	cases.repeats = 1;
+
+	const int fails = run_file_cases(cases, [&](const File &file, int k, const std::string & , std::mt19937 & ){
+		long int nodes, profile_nodes = 0, root_nodes = 0;
+		std::vector<int> solution;
+		bool counts = true;
+
+		std::remove(profile_file.c_str());
+		const double got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "--profile", profile_file}, solution, nodes);
+
+		std::ifstream profile(profile_file);
+		std::string line;
+
+		while(std::getline(profile, line)){
+			if(is_comment(line))
+				continue;
+
+			std::istringstream iss(line);
+			std::vector<double> v {std::istream_iterator<double>(iss), std::istream_iterator<double>()};
+
+			// depth, nodes, leaves, incumbents, bound1 evaluations, prunes and time, bound2 evaluations,
+			// prunes and time, and the accept and ignore branches with their nodes
+			counts = counts && v.size() == 14 && v[5] <= v[4] && v[8] <= v[7] && v[3] <= v[2];
+			profile_nodes += v.size() == 14 ? v[1] : 0;
+			if(v.size() == 14 && v[0] == 0)
+				root_nodes = 1 + v[11] + v[13];
+		}
+
+		const bool okay = counts && profile_nodes == nodes && (root_nodes == nodes || nodes == 1);
+		return CaseResult {got_volume, {}, okay, false, " nodes " + std::to_string(nodes) + " profile nodes " + std::to_string(profile_nodes)};
+	});
+
+	std::remove(profile_file.c_str());
+	return suite_result("profile", fails);
+}
+
+// solves the files on two workers with a trace and checks that it has one line per event and that
+// each task of the workers built its structures
+bool run_trace_tests(){
+	const std::string trace_file = "test.trace";
+	FileCases cases {"trace"};
+	cases.repeats = 1;
+
+	const int fails = run_file_cases(cases, [&](const File &file, int k, const std::string & , std::mt19937 & ){
+		long int nodes, tasks = 0, builds = 0, events = 0;
+		std::vector<int> solution;
+		bool closed = false, lines = true;
+
+		std::remove(trace_file.c_str());
+		const double got_volume = hssp({"-k", std::to_string(k), "-j", "2", file.path + file.name, "-r", file.ref, "--trace", trace_file}, solution, nodes);
+
+		std::ifstream trace(trace_file);
+		std::string line;
+		std::getline(trace, line);
+		lines = line == "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+		while(std::getline(trace, line)){
+			if(line == "]}"){
+				closed = true;
+				continue;
+			}
+
+			lines = lines && !closed && line.compare(0, 9, "{\"name\":\"") == 0 && line.back() == (trace.peek() == ']' ? '}' : ',');
+			tasks += line.find("\"name\":\"task\"") != std::string::npos;
+			builds += line.find("\"name\":\"build\"") != std::string::npos;
+			events++;
+		}
+
+		const bool okay = lines && closed && tasks > 0 && tasks == builds;
+		return CaseResult {got_volume, {}, okay, false, " events " + std::to_string(events) + " tasks " + std::to_string(tasks)};
+	});
+
+	std::remove(trace_file.c_str());
+	return suite_result("trace", fails);
+}
+
+// volume of the best subset of size k of the points found by trying every subset
+double exhaustive_volume(const std::vector<std::vector<double> > &points, std::vector<double> ref, int k){
+	const int n = points.size(), dim = ref.size();
+	std::vector<bool> selected(n, false);
+	std::fill(selected.begin(), selected.begin() + k, true);
+	double best = 0.0;
+
+	do {
+		Point S[k];
+		int s = 0;
+
+		for(int i = 0; i < n; ++i)
+			if(selected[i])
+				S[s++].values = const_cast<double *>(points[i].data());
+
+		best = std::max(best, hypervolume(S, k, dim, ref.data()));
+	} while(std::prev_permutation(selected.begin(), selected.end()));
+
+	return best;
+}
 
-				auto t1 = high_resolution_clock::now();
-				double got_volume = hssp(args, solution, nodes);
-				auto t2 = high_resolution_clock::now();
-				const duration<float> elap = t2 - t1;
+// checks that the generated fronts are nondominated, inside the unit cube and the same for the same
+// seed, and solves small ones against every subset
+bool run_generator_tests(){
+	const std::vector<std::string> families {"linear", "concave", "convex", "cliff", "random"};
+	int fails = 0;
 
-				int type = -1;
-				double expected_volume = 0.0;
+	for(const std::string &name : families){
+		FrontFamily family = FRONT_LINEAR;
+		front_family(name, family);
 
-				if(!volumes.empty() && !positions.empty()){
-					expected_volume = volumes[k-1];
-					type = eq__(got_volume, expected_volume) && (solution == positions[k-1]);
+		for(int dim = family == FRONT_CLIFF ? 3 : 2; dim <= 6; ++dim){
+			const std::vector<std::vector<double> > points = generate_front(family, 200, dim, 7);
+			bool okay = points.size() == 200 && points == generate_front(family, 200, dim, 7) && points != generate_front(family, 200, dim, 8);
+
+			for(int i = 0; okay && i < (int) points.size(); ++i){
+				for(double v : points[i])
+					okay = okay && v >= 0.0 && v < 1.0;
+
+				for(int j = 0; okay && j < (int) points.size(); ++j){
+					bool dominates = i != j;
+					for(int d = 0; d < dim; ++d)
+						dominates = dominates && points[i][d] <= points[j][d];
+
+					okay = !dominates;
 				}
+			}
+
+			std::string msg = "front " + name + " d " + std::to_string(dim) + " n 200";
+
+			if(okay && dim <= 5){
+				const std::vector<std::vector<double> > small = generate_front(family, 14, dim, 7);
+				const std::vector<double> ref(dim, 1.0);
+				SolveOptions options;
+				options.k = 4;
 
-				if(repeat != max_repetitions)
-					continue;
+				const SolveResult result = solve(small, ref, options);
+				const double expected = exhaustive_volume(small, ref, options.k);
+				okay = result.error.empty() && eq__(result.volume, expected);
 
 				std::stringstream ss;
-				ss << std::fixed << std::setprecision(6) << "got " << got_volume << " expected " << expected_volume << " file " << file.name << " nodes " << nodes << " time " << std::fixed << std::setprecision(6) << elap.count() << "s" << " k " << k;
+				ss << std::fixed << std::setprecision(6) << " got " << result.volume << " expected " << expected;
+				msg += ss.str();
+			}
+
+			log_case(okay, msg, fails);
+		}
+	}
+
+	return suite_result("generator", fails);
+}
+
+// counts the hypervolumes of generated fronts on this thread, and solves the files with the counters
+// on one and two workers. the events are only checked when the cpu counts them
+bool run_counters_tests(){
+	int fails = 0;
+
+	for(int dim = 3; dim <= 5; ++dim){
+		const std::vector<std::vector<double> > front = generate_front(FRONT_CONCAVE, 30, dim, 7);
+		const std::vector<double> ref(dim, 0.0);
+		Point *S = new_points(front.size(), dim, true);
+		ThreadCounters counters {};
+
+		for(int i = 0; i < (int) front.size(); ++i)
+			for(int d = 0; d < dim; ++d)
+				S[i].values[d] = front[i][d] - 1.0;
+
+		{
+			ThreadCounting counting(&counters);
+			for(int i = 0; i < 10; ++i)
+				hypervolume(S, front.size(), dim, ref.data());
+		}
+		{
+			ThreadCounting counting(nullptr);
+			hypervolume(S, front.size(), dim, ref.data());
+		}
+
+		// nothing is counted without counters or once the counting ends
+		hypervolume(S, front.size(), dim, ref.data());
+
+		const KernelCounters &kernel = counters.kernels[KERNEL_HYPERVOLUME];
+		bool okay = kernel.calls == 10 && kernel.time > 0.0;
+
+		for(int e : {EVENT_CYCLES, EVENT_INSTRUCTIONS})
+			okay = okay && (!counters.counted[e] || kernel.events[e] > 0.0);
+
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(1) << "hypervolume d " << dim << " calls " << kernel.calls << " ns " << kernel.time << " cycles " << kernel.events[EVENT_CYCLES] << " instructions " << kernel.events[EVENT_INSTRUCTIONS];
+
+		log_case(okay, ss.str(), fails);
+		delete[] S->values;
+		delete[] S;
+	}
+
+	FileCases cases {"counters"};
+	cases.repeats = 1;
+	cases.variants = {"1", "2"};
+
+	fails += run_file_cases(cases, [](const File &file, int k, const std::string &cores, std::mt19937 & ){
+		long int nodes;
+		std::vector<int> solution;
+		const double got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "-j", cores, "--counters"}, solution, nodes);
+
+		return CaseResult {got_volume, {}, true, false, " j " + cores};
+	});
+
+	return suite_result("counters", fails);
+}
+
+// solves generated fronts that changed by two added and two removed points since a previous solve of
+// another size, warm started in memory and from the state file of the command line, and compares them
+// with cold solves. the reused contributions must match the ones computed again
+bool run_warm_tests(){
+	const std::string state_file = "test.warm", previous_file = "test-previous.txt", current_file = "test-current.txt";
+	const int k = 6;
+	int fails = 0;
+
+	for(int dim = 3; dim <= 5; ++dim){
+		const std::vector<std::vector<double> > front = generate_front(FRONT_CONCAVE, 24, dim, 7);
+		const std::vector<double> ref(dim, 1.0);
+		std::vector<std::vector<double> > previous, current {front[0], front[1]};
+		std::vector<int> position(front.size(), -1);
+
+		previous.insert(previous.end(), front.begin() + 2, front.end());
+		for(int i = 4; i < (int) front.size(); ++i){
+			position[i] = current.size();
+			current.push_back(front[i]);
+		}
+
+		SolveOptions options;
+		options.k = k;
+		const SolveResult cold = solve(current, ref, options);
+
+		for(int previous_k : {k - 2, k, k + 2}){
+			SolveOptions previous_options;
+			previous_options.k = previous_k;
+			const SolveResult last = solve(previous, ref, previous_options);
+
+			// the subset is given by index and by coordinates in turns
+			WarmStart warm;
+			warm.added = {0, 1};
+			warm.removed = {front[2], front[3]};
+			warm.contributions.assign(current.size(), 0.0);
+
+			for(int j = 0; j < (int) previous.size(); ++j){
+				const int i = position[j + 2];
+
+				if(i >= 0)
+					warm.contributions[i] = last.contributions[j];
+				if(last.solution[j] && i >= 0 && j % 2)
+					warm.subset.push_back(i);
+				else if(last.solution[j])
+					warm.subset_points.push_back(previous[j]);
+			}
+
+			SolveOptions warm_options;
+			warm_options.k = k;
+			warm_options.warm = &warm;
+			const SolveResult result = solve(current, ref, warm_options);
+
+			bool okay = result.error.empty() && eq__(result.volume, cold.volume) && result.solution == cold.solution;
+			for(int i = 0; okay && i < (int) current.size(); ++i)
+				okay = std::fabs(result.contributions[i] - cold.contributions[i]) < 1e-12;
+
+			std::stringstream ss;
+			ss << std::fixed << std::setprecision(6) << "got " << result.volume << " expected " << cold.volume << " d " << dim << " previous k " << previous_k << " nodes " << result.nodes << " cold nodes " << cold.nodes;
+
+			log_case(okay, ss.str(), fails);
+		}
+
+		// the contributions of another archive are rejected
+		WarmStart invalid;
+		invalid.contributions.assign(current.size() + 1, 0.0);
+		options.warm = &invalid;
+		if(solve(current, ref, options).error.empty()){
+			logger::fail("warm start with one contribution too many d " + std::to_string(dim));
+			fails++;
+		}
+
+		// the command line saves the first solve and starts the second one from it
+		std::ofstream previous_stream(previous_file, std::ofstream::trunc), current_stream(current_file, std::ofstream::trunc);
+		write_front(previous_stream, previous);
+		write_front(current_stream, current);
+		previous_stream.close();
+		current_stream.close();
+
+		const std::string reference = dim == 3 ? "1 1 1" : dim == 4 ? "1 1 1 1" : "1 1 1 1 1";
+		std::vector<int> solution, cold_solution;
+		long int nodes, cold_nodes;
+
+		std::remove(state_file.c_str());
+		hssp({"-k", std::to_string(k + 2), previous_file, "-r", reference, "--warm", state_file}, solution, nodes);
+		const double volume = hssp({"-k", std::to_string(k), current_file, "-r", reference, "--warm", state_file}, solution, nodes);
+		const double again = hssp({"-k", std::to_string(k), current_file, "-r", reference, "--warm", state_file}, solution, nodes);
+		const double cold_volume = hssp({"-k", std::to_string(k), current_file, "-r", reference}, cold_solution, cold_nodes);
+
+		const bool okay = eq__(volume, cold_volume) && eq__(again, cold_volume) && solution == cold_solution;
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(6) << "got " << volume << " expected " << cold_volume << " d " << dim << " state file nodes " << nodes << " cold nodes " << cold_nodes;
+
+		log_case(okay, ss.str(), fails);
+	}
+
+	std::remove(state_file.c_str());
+	std::remove(previous_file.c_str());
+	std::remove(current_file.c_str());
+
+	return suite_result("warm", fails);
+}
+
+// races the searches of the portfolio on the validation files, and checks that the sequential search,
+// which runs the default order, still expands the nodes it expanded before the orders were configurable
+bool run_portfolio_tests(){
+	int fails = run_file_cases({"portfolio"}, [](const File &file, int k, const std::string & , std::mt19937 & ){
+		long int nodes;
+		std::vector<int> solution;
+		const double got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "--portfolio"}, solution, nodes);
+
+		// the searches may end on different subsets of the optimal volume, so only the volume is compared
+		const bool valid = std::count(solution.begin(), solution.end(), 1) == k;
+		return CaseResult {got_volume, {}, valid, false, " nodes " + std::to_string(nodes)};
+	});
+
+	for(const OrderCase &order : default_order_cases){
+		long int nodes;
+		std::vector<int> solution;
+		hssp({"-k", std::to_string(order.k), "test/validation/" + order.file, "-r", "1 1 1"}, solution, nodes);
+
+		log_case(nodes == order.nodes, "default order nodes " + std::to_string(nodes) + " expected " + std::to_string(order.nodes) + " file " + order.file + " k " + std::to_string(order.k), fails);
+	}
+
+	return suite_result("portfolio", fails);
+}
+
+// solves the files on three threads with each policy that decides when a subtree is handed to the pool
+bool run_split_tests(){
+	FileCases cases {"split"};
+	cases.variants = {"idle", "cutoff", "estimate", "hunger"};
+
+	const int fails = run_file_cases(cases, [](const File &file, int k, const std::string &policy, std::mt19937 & ){
+		long int nodes;
+		std::vector<int> solution;
+		const double got_volume = hssp({"-k", std::to_string(k), file.path + file.name, "-r", file.ref, "-j", "3", "--split", policy, "--split-cutoff", "4"}, solution, nodes);
+		return CaseResult {got_volume, solution, true, false, " split " + policy + " nodes " + std::to_string(nodes)};
+	});
+
+	return suite_result("split", fails);
+}
+
+// ids of the cpus of a placement, to compare them with the expected ones
+std::vector<int> placement_ids(const std::vector<Cpu> &placement){
+	std::vector<int> ids;
+	for(const Cpu &cpu : placement)
+		ids.push_back(cpu.id);
+	return ids;
+}
+
+// parses canned cpulists of sysfs and places workers on a machine of two numa nodes of four cores
+// with two hardware threads each, numbered as "0-3,8-11" and "4-7,12-15", where cpus 6, 7, 14 and 15
+// are offline and thus not available to the process
+bool run_topology_tests(){
+	int fails = 0;
+
+	const std::vector<std::pair<std::string, std::vector<int> > > lists {
+		{"0-3,8-11\n", {0, 1, 2, 3, 8, 9, 10, 11}},
+		{"0,2-3,5", {0, 2, 3, 5}},
+		{"7", {7}},
+		{"\n", {}},
+		{"", {}},
+	};
+
+	for(const std::pair<std::string, std::vector<int> > &list : lists)
+		log_case(parse_cpulist(list.first) == list.second, "cpulist '" + list.first.substr(0, list.first.find('\n')) + "' cpus " + std::to_string(parse_cpulist(list.first).size()), fails);
+
+	std::vector<Cpu> cpus;
+	for(int id : parse_cpulist("0-5,8-13"))
+		cpus.push_back({id, -1, id % 8 / 4, id % 4, -1});
+
+	assign_topology(cpus, {{0, "0-3,8-11\n"}, {1, "4-7,12-15\n"}});
+
+	bool nodes = true;
+	for(const Cpu &cpu : cpus)
+		nodes = nodes && cpu.node == cpu.id % 8 / 4 && cpu.sibling == cpu.id / 8;
+	log_case(nodes, "nodes and siblings of " + std::to_string(cpus.size()) + " cpus", fails);
+
+	const std::vector<std::tuple<Affinity, int, std::vector<int> > > placements {
+		{AFFINITY_NONE, 4, {}},
+		{AFFINITY_COMPACT, 4, {0, 8, 1, 9}},
+		{AFFINITY_COMPACT, 14, {0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 0, 8}},
+		{AFFINITY_SCATTER, 4, {0, 4, 1, 5}},
+		{AFFINITY_SCATTER, 14, {0, 4, 1, 5, 2, 3, 8, 12, 9, 13, 10, 11, 0, 4}},
+	};
+
+	for(const std::tuple<Affinity, int, std::vector<int> > &placement : placements){
+		const std::vector<int> ids = placement_ids(place_workers(std::get<0>(placement), cpus, std::get<1>(placement)));
+
+		std::stringstream ss;
+		ss << "affinity " << std::get<0>(placement) << " workers " << std::get<1>(placement) << " cpus";
+		for(int id : ids)
+			ss << " " << id;
+
+		log_case(ids == std::get<2>(placement), ss.str(), fails);
+	}
+
+	// without the nodes in sysfs every cpu is in node 0
+	std::vector<Cpu> flat = cpus;
+	for(Cpu &cpu : flat)
+		cpu.node = -1;
+	assign_topology(flat, {});
+	const std::vector<int> ids = placement_ids(place_workers(AFFINITY_SCATTER, flat, 8));
+	log_case(ids == std::vector<int> {0, 1, 2, 3, 4, 5, 8, 9}, "scatter without nodes", fails);
+
+	return suite_result("topology", fails);
+}
+
+// reads a file with the parser of regular files, which maps them, or with the stream parser, which
+// reads pipes and files whose first point has no coordinates
+Parsed parse_file(const std::string &path, const std::string &reference, int cores, bool mapped){
+	Problem P {};
+	init_problem(&P);
+	P.silent = true;
+	P.cores = cores;
+
+	std::istringstream iss(reference);
+	std::vector<double> ref {std::istream_iterator<double>(iss), std::istream_iterator<double>()};
+	std::ifstream file(path);
+
+	if(!(mapped ? read_points(path, file, ref, &P) : read_input(file, ref, &P)))
+		return Parsed {P.error, 0, 0, {}};
+
+	Parsed parsed {"", P.n, P.dim, std::vector<double>(P.X->values, P.X->values + P.n * P.dim)};
+	clear_memory(&P);
+	return parsed;
+}
+
+// compares the points and errors of the parser of regular files with those of the stream parser
+bool run_parser_tests(){
+	const std::string input_file = "test.points";
+	int fails = 0;
+
+	const std::vector<std::pair<std::string, std::string> > inputs {
+		{"points", "1 2 3\n4 5 6\n"},
+		{"signs", "+1 -2 .5\n-.25 +.75 -0.5\n"},
+		{"exponents", "1e-3 2.5E+0 -3e0\n"},
+		{"no newline at the end", "1 2 3\n4 5 6"},
+		{"crlf", "1 2 3\r\n4 5 6\r\n"},
+		{"tabs", "\t1\t2 3 \n 4 5\t6\t\n"},
+		{"comments and blank lines", "# points\n\n  \n1 2 3\n  # more\n\n4 5 6\n\n"},
+		{"text after the coordinates", "1 2 3 a\n4 5 6 # comment\n"},
+		{"extra coordinate in the first point", "1 2 3 7\n4 5 6\n"},
+		{"extra coordinate in a later point", "1 2 3\n4 5 6 7\n"},
+		{"missing coordinate", "1 2 3\n4 5\n"},
+		{"text between the coordinates", "1 2 3\n4 a 6\n"},
+		{"inf", "1 2 3\n4 inf 6\n"},
+		{"nan", "1 2 3\nnan 5 6\n"},
+		{"out of range", "1 2 3\n4 1e999 6\n"},
+		{"not dominated", "1 2 3\n4 11 6\n"},
+		{"only comments", "# no points\n"},
+	};
+
+	for(const std::pair<std::string, std::string> &input : inputs){
+		for(std::string reference : {"10 10 10", "10 10"}){
+			std::ofstream(input_file) << input.second;
+			const Parsed mapped = parse_file(input_file, reference, 1, true), stream = parse_file(input_file, reference, 1, false);
+
+			const bool okay = mapped.error == stream.error && mapped.n == stream.n && mapped.dim == stream.dim && mapped.values == stream.values;
+			const std::string error = mapped.error.empty() ? "no error" : mapped.error.substr(0, mapped.error.find('\n'));
+			log_case(okay, input.first + " reference " + reference + " points " + std::to_string(mapped.n) + " " + error, fails);
+		}
+	}
+
+	// a file larger than a chunk is parsed in parallel, split at arbitrary lines of the file
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+	std::ofstream large(input_file);
+	large << std::setprecision(17);
 
-				if(type == -1)
-					logger::warn(ss.str());
-				else if(type == 0)
-					logger::fail(ss.str());
-				else if(type == 1)
-					logger::okay(ss.str());
+	for(int i = 0; i < 50000; ++i){
+		if(i % 997 == 0)
+			large << "# comment " << i << "\n\n";
+		large << coordinate(rng) << " " << coordinate(rng) << " " << coordinate(rng) << "\n";
+	}
+	large.close();
+
+	const Parsed stream = parse_file(input_file, "1 1 1", 1, false);
+	for(int cores : {1, 2, 3, 7}){
+		const Parsed mapped = parse_file(input_file, "1 1 1", cores, true);
+		const bool okay = mapped.error.empty() && stream.error.empty() && mapped.n == stream.n && mapped.values == stream.values;
+		log_case(okay, "large file j " + std::to_string(cores) + " points " + std::to_string(mapped.n) + " expected " + std::to_string(stream.n), fails);
+	}
+
+	std::remove(input_file.c_str());
+	return suite_result("parser", fails);
+}
+
+// solves a batch and returns what it printed
+std::string batch_output(std::vector<std::string> args, CancelToken *cancel, bool *stopped, bool *read = nullptr){
+	std::stringstream output;
+	std::streambuf *stdout_buffer = std::cout.rdbuf(output.rdbuf());
+
+	const bool all_read = run_batch(args, cancel, stopped);
+	std::cout.rdbuf(stdout_buffer);
+
+	if(read)
+		*read = all_read;
+
+	return output.str();
+}
+
+// solves the small validation files as the sets of one batch, with a set that has text in place of
+// a number and one with points of different dimensions between them. the results must be printed in
+// the order of the sets for any number of threads, and a cancelled batch prints a prefix of them
+bool run_batch_tests(){
+	const std::string batch_file = "test.batch";
+	const int k = 5;
+	int fails = 0;
+
+	std::vector<const File *> files;
+	std::ofstream batch(batch_file);
+
+	for(const File &file : test_files){
+		if(file.output_type != 1 || file.size > 40)
+			continue;
+
+		std::ifstream points(file.path + file.name);
+		batch << points.rdbuf() << "\n";
+		files.push_back(&file);
+
+		if(files.size() == 2){
+			batch << "0.1 0.2 O.3\n0.2 0.1 0.3\n\n";
+			files.push_back(nullptr);
+		}
+		if(files.size() == 5){
+			batch << "0.1 0.2 0.3\n0.2 0.1\n\n";
+			files.push_back(nullptr);
+		}
+	}
+	batch.close();
+
+	std::string sequential;
+	for(std::string cores : {"1", "4"}){
+		CancelToken cancel;
+		bool stopped;
+		const std::string output = batch_output({"--batch", "-k", std::to_string(k), "-r", "1 1 1", "-j", cores, batch_file}, &cancel, &stopped);
 
-				total_nodes += nodes;
+		std::istringstream lines(output);
+		std::string volume, solution;
+		int instance = 0, wrong = 0;
+
+		while(std::getline(lines, volume) && std::getline(lines, solution)){
+			const File *file = instance < (int) files.size() ? files[instance] : nullptr;
+			const std::string error = "hssp: instance " + std::to_string(instance + 1) + ": ";
+			instance++;
+
+			if(!file){
+				wrong += volume.compare(0, error.size(), error) != 0 || !solution.empty();
+				continue;
 			}
+
+			std::istringstream flags(solution);
+			const std::vector<int> got {std::istream_iterator<int>(flags), std::istream_iterator<int>()};
+			wrong += !eq__(std::stod(volume), load_outputs(*file)[k-1]) || got != load_positions(*file)[k-1];
 		}
+
+		if(cores == "1")
+			sequential = output;
+
+		const bool okay = !stopped && instance == (int) files.size() && wrong == 0 && output == sequential;
+		log_case(okay, "batch j " + cores + " sets " + std::to_string(instance) + " expected " + std::to_string(files.size()) + " wrong " + std::to_string(wrong), fails);
+	}
+
+	const std::vector<std::string> errors {"hssp: instance 3: invalid number in point 1", "hssp: instance 6: invalid input data point or reference point dimension"};
+	for(const std::string &error : errors)
+		log_case(sequential.find(error + "\n\n") != std::string::npos, "error line '" + error + "'", fails);
+
+	// a cancel stops the batch after the sets solved before the first one that was not
+	const std::vector<std::string> args {"--batch", "-k", std::to_string(k), "-r", "1 1 1", "-j", "2", batch_file, batch_file, batch_file};
+	CancelToken never;
+	bool stopped;
+	const std::string full = batch_output(args, &never, &stopped);
+
+	for(int delay : {0, 2, 10}){
+		CancelToken cancel;
+		std::string output;
+
+		std::thread solver([&]{
+			output = batch_output(args, &cancel, &stopped);
+		});
+
+		std::this_thread::sleep_for(milliseconds(delay));
+		cancel.cancel();
+		solver.join();
+
+		const long int lines = std::count(output.begin(), output.end(), '\n');
+		const bool prefix = full.compare(0, output.size(), output) == 0;
+		log_case(stopped && prefix && lines % 2 == 0, "cancel after " + std::to_string(delay) + "ms lines " + std::to_string(lines) + " stopped " + std::to_string(stopped), fails);
+	}
+
+	// a file that can not be read, as a directory, ends the batch with an error after the sets before it
+	bool read;
+	const std::string unread = batch_output({"--batch", "-k", std::to_string(k), "-r", "1 1 1", batch_file, "test"}, &never, &stopped, &read);
+	const std::string error = "hssp: could not read file 'test'\n";
+	log_case(!read && unread == sequential + error, "unreadable file", fails);
+
+	std::remove(batch_file.c_str());
+	return suite_result("batch", fails);
+}
+
+// cases of a tier of the performance tests. quick solves the small files on one thread, full solves
+// every validation file on one and four threads, and long also solves the larger files on one thread
+std::vector<PerfCase> perf_cases(const std::string &tier){
+	std::vector<PerfCase> cases;
+	const std::vector<int> threads = tier == "quick" ? std::vector<int> {1} : std::vector<int> {1, 4};
+
+	for(const File &file : test_files){
+		if(tier == "quick" && file.size > 40)
+			continue;
+
+		for(int k : {file.size / 4, file.size / 2})
+			for(int cores : threads)
+				cases.push_back({file.path + file.name, file.ref, k, cores, 0.0, 0.0, 0, 0});
+	}
+
+	for(const File &file : long_test_files){
+		if(tier != "long")
+			break;
+
+		for(int k : file.size < 100 ? std::vector<int> {5, 10} : std::vector<int> {5})
+			cases.push_back({file.path + file.name, file.ref, k, 1, 0.0, 0.0, 0, 0});
+	}
+
+	return cases;
+}
+
+// solves a case in a child process, so the peak resident memory is that of the case alone
+bool run_perf_case(PerfCase &c){
+	int fds[2];
+	if(pipe(fds))
+		return false;
+
+	fflush(stdout);
+	const pid_t pid = fork();
+
+	if(pid == 0){
+		long int nodes = 0;
+		std::vector<int> solution;
+		close(fds[0]);
+
+		const high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		const double volume = hssp({"-k", std::to_string(c.k), c.file, "-r", c.ref, "-j", std::to_string(c.cores)}, solution, nodes);
+		const duration<double> elapsed = high_resolution_clock::now() - t0;
+
+		const double values[3] = {volume, elapsed.count(), (double) nodes};
+		_exit(write(fds[1], values, sizeof(values)) == sizeof(values) ? 0 : 1);
 	}
 
-	logger::info("total nodes " + std::to_string(total_nodes));
+	double values[3];
+	int status = 0;
+	rusage usage {};
+
+	close(fds[1]);
+	const bool received = pid > 0 && read(fds[0], values, sizeof(values)) == sizeof(values);
+	close(fds[0]);
+
+	if(pid > 0)
+		wait4(pid, &status, 0, &usage);
+	if(!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return false;
+
+	c.volume = values[0];
+	c.time = values[1];
+	c.nodes = values[2];
+	c.rss = usage.ru_maxrss;
+	return true;
+}
+
+// writes the cases with one case per line, which is also how the baseline is read
+bool write_baseline(const std::string &path, const std::string &tier, const std::vector<PerfCase> &cases){
+	std::ofstream file(path, std::ofstream::trunc);
+	file << "{\"tier\":\"" << tier << "\",\"cases\":[";
+
+	for(int i = 0; i < (int) cases.size(); ++i){
+		const PerfCase &c = cases[i];
+		file << (i ? ",\n" : "\n") << "{\"file\":\"" << c.file << "\",\"k\":" << c.k << ",\"j\":" << c.cores;
+		file << ",\"volume\":" << std::scientific << std::setprecision(PRECISION) << c.volume;
+		file << ",\"nodes\":" << c.nodes << ",\"time\":" << std::fixed << std::setprecision(6) << c.time;
+		file << ",\"nps\":" << (long int) (c.time > 0 ? c.nodes / c.time : 0) << ",\"rss_kb\":" << c.rss << "}";
+	}
+
+	file << "\n]}\n";
+	file.close();
+	return file.good();
+}
+
+// value of a key in a line of a baseline
+std::string json_value(const std::string &line, const std::string &key){
+	const size_t pos = line.find("\"" + key + "\":");
+	if(pos == std::string::npos)
+		return "";
+
+	size_t begin = pos + key.size() + 3;
+	if(line[begin] == '"')
+		return line.substr(begin + 1, line.find('"', begin + 1) - begin - 1);
+
+	return line.substr(begin, line.find_first_of(",}", begin) - begin);
+}
+
+std::map<std::tuple<std::string, int, int>, PerfCase> read_baseline(const std::string &path){
+	std::map<std::tuple<std::string, int, int>, PerfCase> baseline;
+	std::ifstream file(path);
+	std::string line;
+
+	while(std::getline(file, line)){
+		PerfCase c {json_value(line, "file"), "", 0, 0, 0.0, 0.0, 0, 0};
+
+		if(c.file.empty() || stoi__(&c.k, json_value(line, "k")) || stoi__(&c.cores, json_value(line, "j")) || stod__(&c.volume, json_value(line, "volume")) || stod__(&c.time, json_value(line, "time")))
+			continue;
+
+		c.nodes = std::atol(json_value(line, "nodes").c_str());
+		c.rss = std::atol(json_value(line, "rss_kb").c_str());
+		baseline[std::make_tuple(c.file, c.k, c.cores)] = c;
+	}
+
+	return baseline;
+}
+
+// solves the cases of a tier and compares their nodes, time and peak memory with a baseline. a case
+// fails when it finds another volume or when one of them grows by more than its tolerance. node
+// counts are only compared on one thread, since they depend on the timing of the threads otherwise,
+// and times and memory must also grow by more than 50 ms and 1 MB. the baseline is written instead
+// when it does not exist or with '--record'
+bool run_perf_tests(std::vector<std::string> args){
+	std::string tier = "quick", baseline_file;
+	double node_tolerance = 0.0, time_tolerance = 0.25, rss_tolerance = 0.25;
+	bool record = false;
+	int fails = 0;
+
+	for(std::vector<std::string>::iterator it = args.begin(); it != args.end(); ++it){
+		const bool last = std::next(it) == args.end();
+		bool invalid = false;
+
+		if(*it == "--tier" && !last)
+			tier = *++it;
+		else if(*it == "--baseline" && !last)
+			baseline_file = *++it;
+		else if(*it == "--record")
+			record = true;
+		else if(*it == "--node-tolerance" && !last)
+			invalid = stod__(&node_tolerance, *++it);
+		else if(*it == "--time-tolerance" && !last)
+			invalid = stod__(&time_tolerance, *++it);
+		else if(*it == "--rss-tolerance" && !last)
+			invalid = stod__(&rss_tolerance, *++it);
+		else if(*it != "--test-perf")
+			invalid = true;
+
+		if(invalid || (tier != "quick" && tier != "full" && tier != "long")){
+			logger::fail("usage: hssp-test --test-perf [--tier quick|full|long] [--baseline F] [--record] [--node-tolerance X] [--time-tolerance X] [--rss-tolerance X]");
+			return false;
+		}
+	}
+
+	if(baseline_file.empty())
+		baseline_file = "perf." + tier + ".json";
+
+	std::map<std::tuple<std::string, int, int>, PerfCase> baseline = read_baseline(baseline_file);
+	std::vector<PerfCase> cases = perf_cases(tier);
+	record = record || baseline.empty();
+
+	for(PerfCase &c : cases){
+		std::stringstream ss;
+		ss << c.file << " k " << c.k << " j " << c.cores;
+
+		if(!run_perf_case(c)){
+			logger::fail(ss.str() + " failed to run");
+			fails++;
+			continue;
+		}
+
+		ss << " nodes " << c.nodes << std::fixed << std::setprecision(6) << " time " << c.time << "s rss " << c.rss << "KB";
+
+		const auto it = baseline.find(std::make_tuple(c.file, c.k, c.cores));
+		if(record || it == baseline.end()){
+			logger::info(ss.str() + (record ? "" : " not in the baseline"));
+			continue;
+		}
+
+		const PerfCase &b = it->second;
+		const bool volume = eq__(c.volume, b.volume);
+		const bool nodes = c.cores > 1 || c.nodes <= b.nodes * (1.0 + node_tolerance);
+		const bool time = c.time <= b.time * (1.0 + time_tolerance) || c.time - b.time <= 0.05;
+		const bool rss = c.rss <= b.rss * (1.0 + rss_tolerance) || c.rss - b.rss <= 1024;
+
+		ss << " baseline nodes " << b.nodes << " time " << b.time << "s rss " << b.rss << "KB";
+		ss << (volume ? "" : " volume changed") << (nodes ? "" : " nodes regressed") << (time ? "" : " time regressed") << (rss ? "" : " rss regressed");
+
+		if(volume && nodes && time && rss)
+			logger::okay(ss.str());
+		else
+			logger::fail(ss.str());
+
+		fails += !(volume && nodes && time && rss);
+	}
+
+	if(record && !write_baseline(baseline_file, tier, cases)){
+		logger::fail("failed to write baseline '" + baseline_file + "'");
+		fails++;
+	}
+	else if(record)
+		logger::info("recorded baseline '" + baseline_file + "'");
+
+	logger::info("perf fails " + std::to_string(fails));
+	return fails == 0;
+}
+
+// runs the validation, or the tests of the option given
+int main(int argc, char **argv){
+	std::vector<std::string> args(argv+1, argv+argc);
+
+	if(contains(args, std::string("--test-checkpoint")))
+		return run_checkpoint_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-distributed")))
+		return run_distributed_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-deterministic")))
+		return run_deterministic_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-cancel")))
+		return run_cancel_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-solver")))
+		return run_solver_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-binary")))
+		return run_binary_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-daemon")))
+		return run_daemon_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-profile")))
+		return run_profile_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-trace")))
+		return run_trace_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-generator")))
+		return run_generator_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-counters")))
+		return run_counters_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-warm")))
+		return run_warm_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-portfolio")))
+		return run_portfolio_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-split")))
+		return run_split_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-topology")))
+		return run_topology_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-parser")))
+		return run_parser_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-batch")))
+		return run_batch_tests() ? 0 : 1;
+	else if(contains(args, std::string("--test-perf")))
+		return run_perf_tests(args) ? 0 : 1;
+	else
+		return run_validation_tests(args) ? 0 : 1;
 }
@@ -3,6 +3,13 @@
 
 #include "util.h"
 #include "hssp.h"
+#include "solver.h"
+#include "daemon.h"
+#include "generator.h"
+#include "counters.h"
+#include "topology.h"
+#include "parser.h"
+#include "batch.h"
 
 #include <string>    // string, getline, stod, to_string
 #include <fstream>   // ifstream
@@ -12,6 +19,18 @@
 #include <iomanip>   // setprecision
 #include <iostream>  // fixed
 #include <iterator>  // istream_iterator
+#include <random>    // mt19937, uniform_int_distribution
+#include <cstdio>    // remove, fflush
+#include <unistd.h>  // fork, _exit, pipe, alarm
+#include <sys/wait.h> // waitpid
+#include <csignal>   // kill, SIGTERM, SIGALRM
+#include <thread>    // thread, sleep_for, hardware_concurrency
+#include <future>    // future
+#include <deque>     // deque
+#include <map>       // map
+#include <tuple>     // tuple
+#include <sys/resource.h> // rusage, wait4
+#include <functional> // function
 
 using namespace std::chrono;
 
@@ -69,6 +88,109 @@ const std::vector<File> test_files {
 	//{"concave.1s.3d.80.dat", 80, 0, "test/validation/", "1 1 1", ""},
 };
 
-void run_validation_tests();
+// files too slow for the validation tests, only used by the long tier of the performance tests
+const std::vector<File> long_test_files {
+	{"convex.1s.3d.80.dat", 80, 0, "test/validation/", "1 1 1", ""},
+	{"linear.1s.3d.80.dat", 80, 0, "test/validation/", "1 1 1", ""},
+	{"concave.1s.3d.80.dat", 80, 0, "test/validation/", "1 1 1", ""},
+	{"cliff.1s.3d.150.dat", 150, 0, "test/validation/", "1 1 1", ""},
+	{"cliff.1s.3d.200.dat", 200, 0, "test/validation/", "1 1 1", ""},
+	{"convex.1s.3d.200.dat", 200, 0, "test/validation/", "1 1 1", ""},
+	{"linear.1s.3d.200.dat", 200, 0, "test/validation/", "1 1 1", ""},
+	{"concave.1s.3d.200.dat", 200, 0, "test/validation/", "1 1 1", ""},
+};
+
+// nodes of the sequential search in the default order, which bounds with bound2 first and explores the
+// accept branch first, recorded before the portfolio made both orders configurable
+struct OrderCase {
+	std::string file;
+	int k;
+	long int nodes;
+};
+
+const std::vector<OrderCase> default_order_cases {
+	{"convex.1s.3d.30.dat", 12, 333},
+	{"convex.1s.3d.40.dat", 12, 629},
+	{"cliff.1s.3d.40.dat", 12, 35},
+	{"cliff.1s.3d.50.dat", 5, 61},
+	{"linear.1s.3d.20.dat", 5, 343},
+	{"linear.1s.3d.30.dat", 12, 1741},
+	{"concave.1s.3d.40.dat", 18, 8623},
+	{"concave.1s.3d.50.dat", 12, 18065},
+};
+
+// points or error of an input file read by one of the parsers
+struct Parsed {
+	std::string error;
+	int n, dim;
+	std::vector<double> values;
+};
+
+// case of the validation, solved in its own process
+struct ValidationCase {
+	const File *file;
+	int k, cores;
+	pid_t pid;
+	int fd; // read end of the pipe of the process
+	double volume, time;
+	long int nodes;
+	std::vector<int> solution;
+	std::string error; // why the process gave no result
+};
+
+// solve of a performance test and what it measured. the peak resident memory is that of the process
+// the solve ran in, in kilobytes
+struct PerfCase {
+	std::string file, ref;
+	int k, cores;
+	double volume, time;
+	long int nodes, rss;
+};
+
+// small validation files solved by a feature suite. each file with an output and between min_size and
+// max_size points is solved for repeats subset sizes drawn from a generator of seed 7, between 2 and
+// n-2 or in the middle third of the sizes with central_k, once for each variant of the suite
+struct FileCases {
+	std::string suite;
+	int repeats = 3, min_size = 0, max_size = 40;
+	bool central_k = false;
+	std::vector<std::string> variants {""};
+};
+
+// result of the solve of a case. the solution is compared when it is not empty, the volume of a
+// stopped solve only must not be better than the optimal one, and okay has the other checks of the
+// suite
+struct CaseResult {
+	double volume;
+	std::vector<int> solution;
+	bool okay, stopped;
+	std::string details;
+};
+
+typedef std::function<CaseResult(const File & , int , const std::string & , std::mt19937 & )> CaseSolve;
+
+void log_case(bool , const std::string & , int & );
+bool suite_result(const std::string & , int );
+int run_file_cases(const FileCases & , CaseSolve );
+
+bool run_validation_tests(std::vector<std::string> );
+bool run_checkpoint_tests();
+bool run_distributed_tests();
+bool run_deterministic_tests();
+bool run_cancel_tests();
+bool run_solver_tests();
+bool run_binary_tests();
+bool run_daemon_tests();
+bool run_profile_tests();
+bool run_trace_tests();
+bool run_generator_tests();
+bool run_counters_tests();
+bool run_warm_tests();
+bool run_portfolio_tests();
+bool run_split_tests();
+bool run_topology_tests();
+bool run_parser_tests();
+bool run_batch_tests();
+bool run_perf_tests(std::vector<std::string> );
 
 #endif
@@ -0,0 +1,148 @@
+#include "topology.h"
+
+const std::string cpu_path__ = "/sys/devices/system/cpu/cpu";
+const std::string node_path__ = "/sys/devices/system/node/";
+
+int read_int(std::string path, int fallback){
+	int value;
+	std::ifstream file(path);
+	return file >> value ? value : fallback;
+}
+
+// parses lists of cpus such as "0-3,8-11"
+std::vector<int> parse_cpulist(const std::string &list){
+	std::vector<int> cpus;
+	std::string range;
+	std::istringstream ranges(list);
+
+	while(std::getline(ranges, range, ',')){
+		int first, last;
+		char dash;
+		std::istringstream iss(range);
+
+		if(!(iss >> first))
+			continue;
+		if(!(iss >> dash >> last))
+			last = first;
+
+		for(int c = first; c <= last; ++c)
+			cpus.push_back(c);
+	}
+
+	return cpus;
+}
+
+std::string read_line(std::string path){
+	std::string line;
+	std::ifstream file(path);
+	std::getline(file, line);
+	return line;
+}
+
+// sets the numa node of the cpus from the cpulist of each node, or node 0 when no list has them, and
+// numbers the hardware threads of the same core by their sibling index. cpus of a list that are not
+// available are ignored
+void assign_topology(std::vector<Cpu> &cpus, const std::vector<std::pair<int, std::string> > &nodes){
+	for(Cpu &cpu : cpus)
+		cpu.node = 0;
+
+	for(const std::pair<int, std::string> &node : nodes){
+		std::vector<int> cpulist = parse_cpulist(node.second);
+
+		for(Cpu &cpu : cpus)
+			if(contains(cpulist, cpu.id))
+				cpu.node = node.first;
+	}
+
+	for(Cpu &cpu : cpus){
+		cpu.sibling = 0;
+		for(const Cpu &other : cpus)
+			cpu.sibling += other.id < cpu.id && other.package == cpu.package && other.core == cpu.core;
+	}
+}
+
+// cpus available to the process with their numa node, socket and core. when the topology is not
+// exposed in sysfs every cpu is assumed to be a core of node 0
+std::vector<Cpu> read_topology(){
+	std::vector<Cpu> cpus;
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+
+	if(sched_getaffinity(0, sizeof(allowed), &allowed))
+		return cpus;
+
+	for(int c = 0; c < CPU_SETSIZE; ++c){
+		if(!CPU_ISSET(c, &allowed))
+			continue;
+
+		const std::string topology = cpu_path__ + std::to_string(c) + "/topology/";
+		cpus.push_back({c, 0, read_int(topology + "physical_package_id", 0), read_int(topology + "core_id", c), 0});
+	}
+
+	std::vector<std::pair<int, std::string> > nodes;
+	for(int node : parse_cpulist(read_line(node_path__ + "possible")))
+		nodes.push_back({node, read_line(node_path__ + "node" + std::to_string(node) + "/cpulist")});
+
+	assign_topology(cpus, nodes);
+	return cpus;
+}
+
+// cpu of each worker. compact fills the cores of one numa node before the next one while scatter
+// alternates between nodes and uses every physical core before any of their hardware threads
+std::vector<Cpu> place_workers(Affinity affinity, std::vector<Cpu> cpus, int workers){
+	std::vector<Cpu> placement;
+
+	if(affinity == AFFINITY_NONE || cpus.empty())
+		return placement;
+
+	if(affinity == AFFINITY_COMPACT){
+		std::sort(cpus.begin(), cpus.end(), [](const Cpu &a, const Cpu &b) -> bool {
+			return std::tie(a.node, a.package, a.core, a.sibling, a.id) < std::tie(b.node, b.package, b.core, b.sibling, b.id);
+		});
+	}
+	else {
+		std::sort(cpus.begin(), cpus.end(), [](const Cpu &a, const Cpu &b) -> bool {
+			return std::tie(a.sibling, a.node, a.package, a.core, a.id) < std::tie(b.sibling, b.node, b.package, b.core, b.id);
+		});
+
+		const int nodes = 1 + std::max_element(cpus.begin(), cpus.end(), [](const Cpu &a, const Cpu &b) -> bool {
+			return a.node < b.node;
+		})->node;
+
+		// take the next cpu of each node in turn among the cpus of the same sibling index, so that a
+		// node with fewer cores does not give its hardware threads before the other nodes run out of cores
+		std::vector<Cpu> order;
+		std::vector<bool> taken(cpus.size(), false);
+
+		for(size_t first = 0, last; first < cpus.size(); first = last){
+			for(last = first; last < cpus.size() && cpus[last].sibling == cpus[first].sibling; ++last);
+
+			while(order.size() < last)
+				for(int node = 0; node < nodes; ++node)
+					for(size_t c = first; c < last; ++c)
+						if(!taken[c] && cpus[c].node == node){
+							taken[c] = true;
+							order.push_back(cpus[c]);
+							break;
+						}
+		}
+
+		cpus = order;
+	}
+
+	for(int w = 0; w < workers; ++w)
+		placement.push_back(cpus[w % cpus.size()]);
+
+	return placement;
+}
+
+std::vector<Cpu> place_workers(Affinity affinity, int workers){
+	return place_workers(affinity, read_topology(), workers);
+}
+
+bool pin_thread(const Cpu &cpu){
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu.id, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
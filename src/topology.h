@@ -0,0 +1,27 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "util.h"
+
+#include <string>    // string, stoi
+#include <vector>    // vector
+#include <fstream>   // ifstream
+#include <sstream>   // istringstream
+#include <algorithm> // sort, max_element
+#include <tuple>     // tie
+#include <utility>   // pair
+#include <pthread.h> // pthread_setaffinity_np, pthread_self
+#include <sched.h>   // cpu_set_t, sched_getaffinity
+
+struct Cpu {
+	int id, node, package, core, sibling;
+};
+
+std::vector<int> parse_cpulist(const std::string & );
+void assign_topology(std::vector<Cpu> & , const std::vector<std::pair<int, std::string> > & );
+std::vector<Cpu> read_topology();
+std::vector<Cpu> place_workers(Affinity , std::vector<Cpu> , int );
+std::vector<Cpu> place_workers(Affinity , int );
+bool pin_thread(const Cpu & );
+
+#endif
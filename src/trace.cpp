@@ -0,0 +1,69 @@
+#include "trace.h"
+
+// every trace has its own generation, so a thread never reuses the buffer of an earlier trace
+std::atomic<long int> generations__ {0};
+thread_local long int generation__ = -1;
+thread_local TraceBuffer *buffer__ = nullptr;
+
+Trace::Trace() : t0(high_resolution_clock::now()), generation(generations__++) {}
+
+// buffer of the calling thread. the deque keeps the buffers in place as it grows
+TraceBuffer &Trace::buffer(){
+	if(generation__ != generation){
+		std::lock_guard<std::mutex> lg(mtx);
+		buffers.push_back({"thread " + std::to_string(buffers.size()), {}});
+		buffer__ = &buffers.back();
+		generation__ = generation;
+	}
+
+	return *buffer__;
+}
+
+double Trace::now(){
+	const duration<double, std::micro> elapsed = high_resolution_clock::now() - t0;
+	return elapsed.count();
+}
+
+void Trace::name(const std::string &name){
+	buffer().name = name;
+}
+
+void Trace::complete(const char *name, double ts, const char *arg, double value){
+	buffer().events.push_back({name, arg, ts, now() - ts, value, 'X'});
+}
+
+void Trace::instant(const char *name, const char *arg, double value){
+	buffer().events.push_back({name, arg, now(), 0.0, value, 'i'});
+}
+
+// writes one event per line. the threads are named by metadata events
+bool Trace::write(const std::string &path){
+	std::ofstream file(path, std::ofstream::trunc);
+	std::lock_guard<std::mutex> lg(mtx);
+	bool first = true;
+
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	file << std::fixed << std::setprecision(3);
+
+	for(int tid = 0; tid < (int) buffers.size(); ++tid){
+		file << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"" << buffers[tid].name << "\"}}";
+		first = false;
+
+		for(const TraceEvent &event : buffers[tid].events){
+			file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << event.ts;
+
+			if(event.phase == 'X')
+				file << ",\"dur\":" << event.dur;
+			else
+				file << ",\"s\":\"t\"";
+			if(event.arg)
+				file << ",\"args\":{\"" << event.arg << "\":" << std::defaultfloat << std::setprecision(PRECISION) << event.value << std::fixed << std::setprecision(3) << "}";
+
+			file << "}";
+		}
+	}
+
+	file << "\n]}\n";
+	file.close();
+	return file.good();
+}
@@ -0,0 +1,75 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "util.h"
+
+#include <string>    // string, to_string
+#include <vector>    // vector
+#include <deque>     // deque
+#include <fstream>   // ofstream
+#include <iomanip>   // setprecision
+#include <chrono>    // high_resolution_clock, duration
+#include <mutex>     // mutex, unique_lock, lock_guard, try_to_lock
+#include <atomic>    // atomic
+
+using namespace std::chrono;
+
+// event of the timeline of a thread. a complete event spans a duration and an instant one does not.
+// the names are string literals and the times are microseconds since the start of the trace
+struct TraceEvent {
+	const char *name, *arg;
+	double ts, dur, value;
+	char phase;
+};
+
+// events of one thread, only written by that thread
+struct TraceBuffer {
+	std::string name;
+	std::vector<TraceEvent> events;
+};
+
+// timeline of the threads of a search in the trace event format of chrome and perfetto. each thread
+// records into its own buffer, which it registers the first time it records, and the buffers are
+// written once the search ends
+class Trace {
+	std::mutex mtx;
+	std::deque<TraceBuffer> buffers;
+	high_resolution_clock::time_point t0;
+	long int generation;
+
+public:
+	Trace();
+	TraceBuffer &buffer();
+	double now();
+	void name(const std::string & );
+	void complete(const char * , double , const char * = nullptr , double = 0.0 );
+	void instant(const char * , const char * = nullptr , double = 0.0 );
+	bool write(const std::string & );
+};
+
+// records the time from its creation to its destruction as a complete event
+class TraceScope {
+	Trace *trace;
+	const char *name, *arg;
+	double ts;
+
+public:
+	double value = 0.0;
+
+	TraceScope(Trace *trace_, const char *name_, const char *arg_ = nullptr) : trace(trace_), name(name_), arg(arg_), ts(trace_ ? trace_->now() : 0.0) {}
+	~TraceScope(){
+		if(trace)
+			trace->complete(name, ts, arg, value);
+	}
+};
+
+// locks the mutex and records the wait when it was held by another thread
+inline void traced_lock(std::unique_lock<std::mutex> &ul, Trace *trace){
+	if(ul.try_lock())
+		return;
+
+	TraceScope scope(trace, "lock wait");
+	ul.lock();
+}
+
+#endif
@@ -8,7 +8,54 @@ const std::string usage_str =
 	"  -r, --reference R    use R as the reference point (default reference is the origin)\n"
 	"  -k, --subsetsize K   select K points (default subsetsize is half the number of points)\n"
 	"  -j, --concurrency T  use T parallel workers (default concurrency is 1)\n"
-	"  -v, --verbose        displays extra information\n";
+	"  -v, --verbose        displays extra information\n"
+	"      --affinity M     pin the workers to cpus with mode M: compact, scatter or none (default)\n"
+	"      --all-k          solve every subset size up to K (default is every size) and print a line\n"
+	"                       with the size, the hypervolume and the subset of each one\n"
+	"      --batch          solve each point set of the files, or of the standard input, on its own\n"
+	"                       worker. the sets are separated by blank or comment lines and their\n"
+	"                       results are printed in order\n"
+	"      --deterministic  search in the same order and with the same node counts for any concurrency\n"
+	"      --portfolio      race differently configured searches on one thread each, the first to\n"
+	"                       finish stops the others\n"
+	"      --split S        hand subtrees to idle workers with policy S: idle (default), cutoff,\n"
+	"                       estimate or hunger\n"
+	"      --split-cutoff N do not split subtrees with less than N points left (default is 8)\n"
+	"      --profile F      count the evaluations, prunes and time of the bounds and the branches at\n"
+	"                       each depth of the search, write them to file F and print a summary\n"
+	"      --counters       count the time, cycles, instructions, cache misses and branch misses of\n"
+	"                       the hypervolume, bound, update and hvc kernels and of the tasks of the\n"
+	"                       workers, and print them per call\n"
+	"      --trace F        record a timeline of the tasks, locks and idle time of the workers and\n"
+	"                       write it to file F in the chrome trace event format\n"
+	"      --warm F         start from the solve saved in file F of an archive that changed by a few\n"
+	"                       points, and save this solve to it. a missing file is created\n"
+	"      --write-binary F write the normalized points to binary file F and exit. a binary file is\n"
+	"                       given as input like a text file and is loaded without parsing\n"
+	"      --checkpoint F   periodically save the state of the search to file F\n"
+	"      --checkpoint-interval S\n"
+	"                       save the state of the search every S seconds (default is 60)\n"
+	"      --resume F       continue the search saved in file F\n"
+	"      --stop-after N   with '--checkpoint', save the state of the search and stop once N nodes\n"
+	"                       are explored, to be continued with '--resume'\n"
+	"      --serve-workers A\n"
+	"                       split the search among the worker processes connected to address A\n"
+	"      --worker A       search the subproblems given by the coordinator at address A\n"
+	"      --daemon A       solve the requests of the clients connected to address A, -j at a time\n"
+	"      --client A       solve the points on the daemon at address A\n"
+	"      --deadline S     with '--client', stop the search after S seconds\n";
+
+// the searches raced by the portfolio. bound1 prunes more but costs more than bound2, and exploring
+// the ignore branch first finds other incumbents early on some fronts
+const std::vector<Config> portfolio_configs {
+	{"bound2-accept", false, false},
+	{"bound1-accept", true, false},
+	{"bound2-ignore", false, true},
+	{"bound1-ignore", true, true},
+};
+
+const char *kernel_names__[] = {"hypervolume", "update", "bound1", "bound2", "hvc", "work"};
+const char *event_names__[] = {"cycles", "instructions", "l1d-misses", "llc-misses", "branch-misses"};
 
 std::mutex print_mtx__;
 
@@ -46,19 +93,31 @@ namespace logger {
 	}
 }
 
+// sum of a counter over all threads. the counters are read while the threads update them
+long int total(Problem *P, std::atomic<long int> ThreadStats::*counter){
+	long int sum = 0;
+
+	for(int t = 0; P->stats && t < P->cores; ++t)
+		sum += (P->stats[t].*counter).load(std::memory_order_relaxed);
+
+	return sum;
+}
+
 void search_info(std::string msg, Problem *P, int id){
-	if(!P->verbose)
-		return;
+	if(P->progress)
+		P->progress(P, msg);
 
-	const duration<float> fs = high_resolution_clock::now() - P->t0;
-	const long int total_nodes = std::accumulate(P->nodes.begin(), P->nodes.end(), 0);
+	if(P->verbose){
+		const duration<float> fs = high_resolution_clock::now() - P->t0;
+		const long int total_nodes = total(P, &ThreadStats::nodes);
 
-	std::ostringstream lbound;
-	lbound << P->best;
+		std::ostringstream lbound;
+		lbound << P->best;
 
-	std::stringstream ss;
-	ss << "lbound " << std::fixed << std::setprecision(PRECISION) << lbound.str() << " nodes " << total_nodes << " time " << std::fixed << std::setprecision(6) << fs.count() << "s" << " nps " << int(total_nodes / fs.count()) << " thread " << id << " type " << msg;
-	logger::info(ss.str());
+		std::stringstream ss;
+		ss << "lbound " << std::fixed << std::setprecision(PRECISION) << lbound.str() << " nodes " << total_nodes << " time " << std::fixed << std::setprecision(6) << fs.count() << "s" << " nps " << int(total_nodes / fs.count()) << " thread " << id << " type " << msg;
+		logger::info(ss.str());
+	}
 
 	if(P->pingmode){
 		P->ping = high_resolution_clock::now();
@@ -85,21 +144,178 @@ void ping(Problem *P, int id){
 	}
 }
 
+// prints the calls of each kernel with their time and events per call, summed over the threads and
+// with '--verbose' for each thread. the events are those every thread could count
+void counter_info(Problem *P){
+	if(!P->counting)
+		return;
+
+	ThreadCounters all {};
+	std::fill(all.counted, all.counted + EVENTS, !P->counters.empty());
+
+	for(const ThreadCounters &thread : P->counters){
+		for(int e = 0; e < EVENTS; ++e)
+			all.counted[e] = all.counted[e] && thread.counted[e];
+
+		for(int k = 0; k < KERNELS; ++k){
+			all.kernels[k].calls += thread.kernels[k].calls;
+			all.kernels[k].time += thread.kernels[k].time;
+			for(int e = 0; e < EVENTS; ++e)
+				all.kernels[k].events[e] += thread.kernels[k].events[e];
+		}
+	}
+
+	if(std::find(all.counted, all.counted + EVENTS, true) == all.counted + EVENTS)
+		logger::warn("hardware counters are not available, only the time of the kernels is counted");
+
+	auto print = [&](const std::string &name, const KernelCounters &kernel){
+		const double calls = std::max(1l, kernel.calls);
+		std::stringstream ss;
+
+		ss << std::fixed << std::setprecision(1) << name << " calls " << kernel.calls << " ns/call " << kernel.time / calls;
+		for(int e = 0; e < EVENTS; ++e)
+			if(all.counted[e])
+				ss << " " << event_names__[e] << "/call " << kernel.events[e] / calls;
+		if(all.counted[EVENT_CYCLES] && all.counted[EVENT_INSTRUCTIONS] && kernel.events[EVENT_CYCLES] > 0)
+			ss << std::setprecision(2) << " ipc " << kernel.events[EVENT_INSTRUCTIONS] / kernel.events[EVENT_CYCLES];
+
+		logger::info(ss.str());
+	};
+
+	for(int k = 0; k < KERNELS; ++k)
+		if(all.kernels[k].calls)
+			print(std::string("counters ") + kernel_names__[k], all.kernels[k]);
+
+	for(int t = 0; P->verbose && t < (int) P->counters.size(); ++t)
+		for(int k = 0; k < KERNELS; ++k)
+			if(P->counters[t].kernels[k].calls)
+				print("counters thread " + std::to_string(t) + " " + kernel_names__[k], P->counters[t].kernels[k]);
+}
+
 void concurrency_info(Problem *P){
+	// the counters of the kernels are printed with '--counters' alone
+	counter_info(P);
+
 	if(!P->verbose)
 		return;
 
 	for(int t = 0; t < P->cores; ++t)
-		logger::info("thread " + std::to_string(t) + " nodes " + std::to_string(P->nodes[t]));
+		logger::info("thread " + std::to_string(t) + " nodes " + std::to_string(P->stats[t].nodes) + " tasks " + std::to_string(P->stats[t].tasks) + " leaves " + std::to_string(P->stats[t].leaves) + " pruned bound1 " + std::to_string(P->stats[t].pruned_bound1) + " bound2 " + std::to_string(P->stats[t].pruned_bound2) + " incumbents " + std::to_string(P->stats[t].incumbents));
+
+	logger::info("thread tasks " + std::to_string(total(P, &ThreadStats::tasks)));
+
+	// searches raced by the portfolio and the one that finished first
+	for(int t = 0; t < (int) P->portfolio.size(); ++t)
+		logger::info("portfolio " + P->portfolio[t].name + " thread " + std::to_string(t) + " nodes " + std::to_string(P->stats[t].nodes) + " incumbents " + std::to_string(P->stats[t].incumbents) + " won " + std::to_string(t == P->winner));
+
+	// granularity of the tasks given to the pool
+	for(int b = 0; b < (int) P->task_sizes.size(); ++b)
+		if(P->task_sizes[b])
+			logger::info("thread tasks below 2^" + std::to_string(b + 1) + " nodes " + std::to_string(P->task_sizes[b]));
+
+	// nodes of the search explored on each numa node by the pinned workers
+	std::map<int, std::pair<int, long int> > numa;
+
+	for(int t = 0; t < (int) P->numa_nodes.size(); ++t){
+		numa[P->numa_nodes[t]].first++;
+		numa[P->numa_nodes[t]].second += P->stats[t].nodes;
+	}
 
-	logger::info("thread tasks " + std::to_string(P->ntasks));
+	for(const auto &node : numa)
+		logger::info("numa node " + std::to_string(node.first) + " threads " + std::to_string(node.second.first) + " nodes " + std::to_string(node.second.second));
+}
+
+// writes the profile of the threads merged by depth as tab separated lines, one per depth that was
+// reached, and prints a summary of each bound and branch
+void profile_info(Problem *P){
+	if(!P->profiling)
+		return;
+
+	std::vector<DepthProfile> depths(P->n + 1);
+	DepthProfile all {};
+
+	for(const std::vector<DepthProfile> &profile : P->profiles){
+		for(int d = 0; d <= P->n; ++d){
+			const DepthProfile &p = profile[d];
+			for(DepthProfile *q : {&depths[d], &all}){
+				q->nodes += p.nodes;
+				q->leaves += p.leaves;
+				q->incumbents += p.incumbents;
+				q->bound1_evals += p.bound1_evals;
+				q->bound1_prunes += p.bound1_prunes;
+				q->bound1_time += p.bound1_time;
+				q->bound2_evals += p.bound2_evals;
+				q->bound2_prunes += p.bound2_prunes;
+				q->bound2_time += p.bound2_time;
+				q->accepts += p.accepts;
+				q->accept_nodes += p.accept_nodes;
+				q->ignores += p.ignores;
+				q->ignore_nodes += p.ignore_nodes;
+			}
+		}
+	}
+
+	std::ofstream file(P->profile_file, std::ofstream::trunc);
+	file << "# depth\tnodes\tleaves\tincumbents\tbound1_evals\tbound1_prunes\tbound1_ns\tbound2_evals\tbound2_prunes\tbound2_ns\taccepts\taccept_nodes\tignores\tignore_nodes\n";
+	file << std::fixed << std::setprecision(0);
+
+	for(int d = 0; d <= P->n; ++d){
+		const DepthProfile &p = depths[d];
+		if(!p.nodes)
+			continue;
+
+		file << d << "\t" << p.nodes << "\t" << p.leaves << "\t" << p.incumbents << "\t";
+		file << p.bound1_evals << "\t" << p.bound1_prunes << "\t" << p.bound1_time << "\t";
+		file << p.bound2_evals << "\t" << p.bound2_prunes << "\t" << p.bound2_time << "\t";
+		file << p.accepts << "\t" << p.accept_nodes << "\t" << p.ignores << "\t" << p.ignore_nodes << "\n";
+	}
+
+	file.close();
+	if(!file.good())
+		logger::warn("failed to write profile file '" + P->profile_file + "'");
+
+	auto ratio = [](double a, long int b){ return b ? a / b : 0.0; };
+	std::stringstream ss;
+
+	ss << std::fixed << std::setprecision(1) << "profile nodes " << all.nodes << " leaves " << all.leaves << " incumbents " << all.incumbents;
+	logger::info(ss.str());
+
+	ss.str("");
+	ss << "profile bound1 evaluations " << all.bound1_evals << " prunes " << all.bound1_prunes << " (" << 100.0 * ratio(all.bound1_prunes, all.bound1_evals) << "%) " << ratio(all.bound1_time, all.bound1_evals) << " ns/evaluation";
+	logger::info(ss.str());
+
+	ss.str("");
+	ss << "profile bound2 evaluations " << all.bound2_evals << " prunes " << all.bound2_prunes << " (" << 100.0 * ratio(all.bound2_prunes, all.bound2_evals) << "%) " << ratio(all.bound2_time, all.bound2_evals) << " ns/evaluation";
+	logger::info(ss.str());
+
+	// the searches of the portfolio differ in the order of the bounds, so their prunes are compared
+	for(int t = 0; t < (int) P->portfolio.size(); ++t){
+		DepthProfile search {};
+
+		for(const DepthProfile &p : P->profiles[t]){
+			search.nodes += p.nodes;
+			search.bound1_evals += p.bound1_evals;
+			search.bound1_prunes += p.bound1_prunes;
+			search.bound2_evals += p.bound2_evals;
+			search.bound2_prunes += p.bound2_prunes;
+		}
+
+		ss.str("");
+		ss << "profile portfolio " << P->portfolio[t].name << " nodes " << search.nodes << " bound1 prunes " << search.bound1_prunes << "/" << search.bound1_evals << " bound2 prunes " << search.bound2_prunes << "/" << search.bound2_evals;
+		logger::info(ss.str());
+	}
+
+	ss.str("");
+	ss << "profile accept branches " << all.accepts << " mean nodes " << ratio(all.accept_nodes, all.accepts) << " ignore branches " << all.ignores << " mean nodes " << ratio(all.ignore_nodes, all.ignores);
+	logger::info(ss.str());
 }
 
 Point *new_points(int size, int dim, bool alloc_coordinates){
 	Point *S = new Point[size];
+	double *values = alloc_coordinates ? new double[size*dim] : nullptr;
 
-	for(Point *it = S; alloc_coordinates && it != S+size; ++it)
-		it->values = new double[dim];
+	for(Point *it = S; alloc_coordinates && it != S+size; ++it, values += dim)
+		it->values = values;
 
 	return S;
 }
@@ -118,6 +334,16 @@ bool stoi__(int *dest, std::string num){
 	}
 }
 
+// sets dest variable. returns true on failure
+bool stod__(double *dest, std::string num){
+	try {
+		*dest = stod(num);
+		return false;
+	} catch(...){
+		return true;
+	}
+}
+
 void assert__(std::string expr_str, bool expr, std::string file, int line, std::string msg){
 	if(!expr){
 		std::stringstream ss;
@@ -145,7 +371,11 @@ int initial_position(Point *point, Problem *P){
 
 bool is_comment(std::string str){
 	size_t starts_with = str.find_first_not_of(" \t\r\n");
-	return str[starts_with] == '#';
+	return starts_with != std::string::npos && str[starts_with] == '#';
+}
+
+bool is_blank(std::string str){
+	return str.find_first_not_of(" \t\r\n") == std::string::npos;
 }
 
 void print_problem(Problem *P){
@@ -164,6 +394,10 @@ void print_problem(Problem *P){
 std::vector<int> solution_to_vector(Problem *P){
 	std::vector<int> solution(P->n, 0);
 
+	// a search stopped before its first solution has none
+	if(P->best == -INF)
+		return solution;
+
 	for(Point *it = P->solution; it != P->solution + P->k; ++it){
 		const int pos = initial_position(it, P);
 		assert_with_log(pos >= 0, "point is not in the original set");
@@ -174,9 +408,11 @@ std::vector<int> solution_to_vector(Problem *P){
 }
 
 void clear_memory(Problem *P){
-	for(Point *it = P->X; it && it != P->X + P->n; ++it)
-		if(it->values)
-			delete [] it->values;
+	// the coordinates of all points are allocated in a single block, or mapped from a binary file
+	if(P->mapped)
+		munmap(P->mapped, P->mapped_size);
+	else if(P->X && P->n > 0)
+		delete [] P->X->values;
 
 	if(P->X)
 		delete [] P->X;
@@ -184,14 +420,80 @@ void clear_memory(Problem *P){
 		delete [] P->ref;
 	if(P->solution)
 		delete [] P->solution;
+	if(P->stats)
+		delete [] P->stats;
 }
 
-bool ERROR(Problem *P, std::string error_msg = ""){
-	printf("hssp: %s", error_msg.c_str());
+bool ERROR(Problem *P, std::string error_msg){
+	P->error = error_msg;
+	if(!P->silent)
+		printf("hssp: %s", error_msg.c_str());
 	clear_memory(P);
 	return false;
 }
 
+// modes of the program selected by the options, which the table below combines
+enum Mode {
+	MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_WORKER, MODE_DETERMINISTIC, MODE_PORTFOLIO, MODE_BATCH, MODE_ALL_K,
+	MODE_DAEMON, MODE_CLIENT, MODE_PROFILE, MODE_TRACE, MODE_COUNTERS, MODE_WARM, MODE_POINTS, MODE_WRITE_BINARY, MODES
+};
+
+const std::string mode_options__[MODES] = {
+	"--checkpoint", "--resume", "--serve-workers", "--worker", "--deterministic", "--portfolio", "--batch", "--all-k",
+	"--daemon", "--client", "--profile", "--trace", "--counters", "--warm", "--points", "--write-binary"
+};
+
+// modes that can not be used with each mode. checkpoints, workers, the daemon and the batch run the
+// search in a way of their own, and the other modes need a single search of this process
+const std::vector<std::pair<Mode, std::vector<Mode> > > incompatible_modes__ {
+	{MODE_SERVE,         {MODE_CHECKPOINT, MODE_RESUME}},
+	{MODE_DETERMINISTIC, {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE}},
+	{MODE_PORTFOLIO,     {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_DETERMINISTIC}},
+	{MODE_BATCH,         {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_WORKER, MODE_PORTFOLIO, MODE_POINTS, MODE_WRITE_BINARY}},
+	{MODE_ALL_K,         {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_DETERMINISTIC, MODE_PORTFOLIO, MODE_BATCH}},
+	{MODE_DAEMON,        {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_WORKER, MODE_BATCH, MODE_ALL_K}},
+	{MODE_CLIENT,        {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_WORKER, MODE_BATCH, MODE_ALL_K}},
+	{MODE_PROFILE,       {MODE_SERVE, MODE_WORKER, MODE_DAEMON, MODE_CLIENT, MODE_BATCH, MODE_ALL_K}},
+	{MODE_TRACE,         {MODE_SERVE, MODE_WORKER, MODE_DAEMON, MODE_CLIENT, MODE_BATCH, MODE_ALL_K}},
+	{MODE_COUNTERS,      {MODE_SERVE, MODE_WORKER, MODE_DAEMON, MODE_CLIENT, MODE_BATCH, MODE_ALL_K}},
+	{MODE_WARM,          {MODE_CHECKPOINT, MODE_RESUME, MODE_SERVE, MODE_WORKER, MODE_DAEMON, MODE_CLIENT, MODE_BATCH, MODE_ALL_K}},
+};
+
+// checks the options that do not depend on the input points and derives the settings they imply
+bool check_options(Problem *P){
+	if(P->cores <= 0)
+		return ERROR(P, "invalid concurrency value \'" + std::to_string(P->cores) + "\'\n" + tryhelp_str);
+	if(P->stop_after > 0 && P->checkpoint_file.empty())
+		return ERROR(P, "option '--stop-after' requires a checkpoint file\n" + tryhelp_str);
+
+	const bool modes[MODES] = {
+		!P->checkpoint_file.empty(), !P->resume_file.empty(), !P->serve_address.empty(), !P->worker_address.empty(),
+		P->deterministic, !P->portfolio.empty(), P->batch, P->all_k, !P->daemon_address.empty(), !P->client_address.empty(),
+		!P->profile_file.empty(), !P->trace_file.empty(), P->counting, !P->warm_file.empty(), P->printpointsonly, !P->binary_file.empty()
+	};
+
+	for(const std::pair<Mode, std::vector<Mode> > &incompatible : incompatible_modes__)
+		for(Mode mode : incompatible.second)
+			if(modes[incompatible.first] && modes[mode])
+				return ERROR(P, "option '" + mode_options__[incompatible.first] + "' can not be used with '" + mode_options__[mode] + "'\n" + tryhelp_str);
+
+	if(P->deadline > 0 && P->client_address.empty())
+		return ERROR(P, "option '--deadline' requires '--client'\n" + tryhelp_str);
+	if(!P->batch && P->input_files.size() > 1)
+		return ERROR(P, "only one input file can be given without '--batch'\n" + tryhelp_str);
+	if(P->batch && P->kset && P->k <= 0)
+		return ERROR(P, "invalid subset size \'" + std::to_string(P->k) + "\'\n" + tryhelp_str);
+
+	// each search of the portfolio runs on its own thread
+	if(!P->portfolio.empty())
+		P->cores = P->portfolio.size();
+
+	P->checkpointing = !P->checkpoint_file.empty();
+	P->profiling = !P->profile_file.empty();
+
+	return true; // no error
+}
+
 bool read_args(std::vector<std::string> args, std::vector<double> &ref, std::ifstream &file, Problem *P){
 	if(contains(args, std::string("--help") ))
 		return ERROR(P, usage_str + "\n");
@@ -221,10 +523,133 @@ bool read_args(std::vector<std::string> args, std::vector<double> &ref, std::ifs
 			P->pingmode = true;
 		else if(*it == "--points")
 			P->printpointsonly = true;
+		else if(*it == "--write-binary"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--write-binary' requires an argument\n" + tryhelp_str);
+
+			P->binary_file = *++it;
+		}
 		else if(*it == "--devmode")
 			P->devmode = true;
+		else if(*it == "--deterministic")
+			P->deterministic = true;
+		else if(*it == "--batch")
+			P->batch = true;
+		else if(*it == "--all-k")
+			P->all_k = true;
+		else if(*it == "--portfolio")
+			P->portfolio = portfolio_configs;
+		else if(*it == "--profile"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--profile' requires an argument\n" + tryhelp_str);
+
+			P->profile_file = *++it;
+		}
+		else if(*it == "--counters")
+			P->counting = true;
+		else if(*it == "--trace"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--trace' requires an argument\n" + tryhelp_str);
+
+			P->trace_file = *++it;
+		}
+		else if(*it == "--warm"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--warm' requires an argument\n" + tryhelp_str);
+
+			P->warm_file = *++it;
+		}
+		else if(*it == "--checkpoint"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--checkpoint' requires an argument\n" + tryhelp_str);
+
+			P->checkpoint_file = *++it;
+		}
+		else if(*it == "--checkpoint-interval"){
+			if(std::next(it) == args.end() || stod__(&P->checkpoint_interval, *++it) || P->checkpoint_interval < 0)
+				return ERROR(P, "invalid checkpoint interval\n" + tryhelp_str);
+		}
+		else if(*it == "--resume"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--resume' requires an argument\n" + tryhelp_str);
+
+			P->resume_file = *++it;
+		}
+		else if(*it == "--affinity"){
+			const std::string mode = std::next(it) != args.end() ? *++it : "";
+
+			if(mode == "compact")
+				P->affinity = AFFINITY_COMPACT;
+			else if(mode == "scatter")
+				P->affinity = AFFINITY_SCATTER;
+			else if(mode == "none")
+				P->affinity = AFFINITY_NONE;
+			else
+				return ERROR(P, "invalid affinity mode '" + mode + "'\n" + tryhelp_str);
+		}
+		else if(*it == "--split"){
+			const std::string policy = std::next(it) != args.end() ? *++it : "";
+
+			if(policy == "idle")
+				P->split = SPLIT_IDLE;
+			else if(policy == "cutoff")
+				P->split = SPLIT_CUTOFF;
+			else if(policy == "estimate")
+				P->split = SPLIT_ESTIMATE;
+			else if(policy == "hunger")
+				P->split = SPLIT_HUNGER;
+			else
+				return ERROR(P, "invalid split policy '" + policy + "'\n" + tryhelp_str);
+		}
+		else if(*it == "--split-cutoff"){
+			if(std::next(it) == args.end() || stoi__(&P->split_cutoff, *++it) || P->split_cutoff < 0)
+				return ERROR(P, "invalid split cutoff\n" + tryhelp_str);
+		}
+		else if(*it == "--serve-workers"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--serve-workers' requires an argument\n" + tryhelp_str);
+
+			P->serve_address = *++it;
+		}
+		else if(*it == "--worker"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--worker' requires an argument\n" + tryhelp_str);
+
+			P->worker_address = *++it;
+		}
+		else if(*it == "--daemon"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--daemon' requires an argument\n" + tryhelp_str);
+
+			P->daemon_address = *++it;
+		}
+		else if(*it == "--client"){
+			if(std::next(it) == args.end())
+				return ERROR(P, "option '--client' requires an argument\n" + tryhelp_str);
+
+			P->client_address = *++it;
+		}
+		else if(*it == "--deadline"){
+			if(std::next(it) == args.end() || stod__(&P->deadline, *++it) || P->deadline <= 0)
+				return ERROR(P, "invalid deadline\n" + tryhelp_str);
+		}
+		else if(*it == "--stop-after"){
+			int nodes;
+			if(std::next(it) == args.end() || stoi__(&nodes, *++it) || nodes <= 0)
+				return ERROR(P, "invalid number of nodes for '--stop-after'\n" + tryhelp_str);
+
+			P->stop_after = nodes;
+		}
 		else {
+			P->input_files.push_back(*it);
+
+			// the standard input of a batch
+			if(*it == "-")
+				continue;
+
+			file.close();
 			file.open(*it, std::ifstream::in);
+			P->input_file = *it;
 
 			// is this an input file?
 			if(!file.good() && *it != "--help")
@@ -232,12 +657,12 @@ bool read_args(std::vector<std::string> args, std::vector<double> &ref, std::ifs
 		}
 	}
 
-	if(!file.good())
+	// the points of a worker are given by the coordinator, those of a daemon by its clients, and a
+	// batch reads the standard input when it has no file
+	if(!file.good() && P->worker_address.empty() && P->daemon_address.empty() && !P->batch)
 		return ERROR(P, "no file input specified\n" + tryhelp_str);
-	if(P->cores <= 0)
-		return ERROR(P, "invalid concurrency value \'" + std::to_string(P->cores) + "\'\n" + tryhelp_str);
 
-	return true; // no error
+	return check_options(P);
 }
 
 bool read_input(std::ifstream &file, std::vector<double> &ref, Problem *P){
@@ -246,7 +671,8 @@ bool read_input(std::ifstream &file, std::vector<double> &ref, Problem *P){
 	std::back_insert_iterator<std::vector<double> > it = std::back_inserter(values);
 
 	while(std::getline(file, line)){
-		if(is_comment(line))
+		// blank lines are skipped like comments, as by the parser of mapped files
+		if(is_blank(line) || is_comment(line))
 			continue;
 
 		std::istringstream iss(line);
@@ -262,8 +688,12 @@ bool read_input(std::ifstream &file, std::vector<double> &ref, Problem *P){
 		P->dim = (int) insert_dims;
 	}
 
-	P->n = P->dim == 0 ? 0 : (int) values.size() / P->dim;
+	file.close();
+	return load_points(values, ref, P);
+}
 
+// checks the number of points and the subset size once the points are known
+bool check_size(Problem *P){
 	if(P->n <= 0)
 		return ERROR(P, "no input data given\n" + tryhelp_str);
 	if(P->k > P->n || P->k < 0 || (P->k == 0 && P->kset))
@@ -272,24 +702,28 @@ bool read_input(std::ifstream &file, std::vector<double> &ref, Problem *P){
 	if(P->k == 0 && !P->kset)
 		P->k = P->n/2;
 
+	return true;
+}
+
+// loads the n points given as one block of n times dim values. they are normalized to the origin
+// reference point of a minimization problem
+bool load_points(const std::vector<double> &values, std::vector<double> &ref, Problem *P){
+	P->n = P->dim == 0 ? 0 : (int) values.size() / P->dim;
+
+	if(!check_size(P))
+		return false;
+
 	ref.resize(P->dim, 0.0);
 	P->ref = new double[P->dim]();
 	P->X = new_points(P->n, P->dim, true);
 
-	for(int i = 0; i < P->n; ++i){
-		for(int j = 0; j < P->dim; ++j){
-			const double value = values[i*P->dim+j];
-			if((P->maximize && (ref[j] >= value)) || (!P->maximize && (ref[j] <= value)))
+	for(int i = 0; i < P->n; ++i)
+		for(int j = 0; j < P->dim; ++j)
+			if(!normalize(values[i*P->dim+j], ref[j], P->X[i].values[j], P))
 				return ERROR(P, "reference point must dominate input data points\n");
 
-			// normalize data to the origin reference point and transform it to minimization problem
-			P->X[i].values[j] = (value - ref[j]) * (!P->maximize - P->maximize);
-		}
-	}
-
 	P->solution = new_points(P->n, P->dim, false);
 	P->initialized = true;
 
-	file.close();
 	return true;
 }
@@ -17,8 +17,13 @@
 #include <chrono>    // high_resolution_clock, time_point, duration
 #include <mutex>     // mutex, unique_lock, lock_guard, try_to_lock
 #include <set>       // set
+#include <map>       // map
 #include <cstdlib>   // abort
 #include <limits>    // numeric_limits
+#include <atomic>    // atomic
+#include <utility>   // pair
+#include <functional> // function
+#include <sys/mman.h> // munmap
 
 #define INF std::numeric_limits<double>::infinity()
 #define PRECISION 15
@@ -47,16 +52,115 @@ struct Point {
 	double z() const { return values[2]; }
 };
 
+// decisions taken by a thread since the subproblem it started from. used to save the search
+struct SearchPath {
+	std::vector<int> accepted, remaining;       // initial positions of the points of the subproblem
+	std::vector<std::pair<int, bool> > frames;  // point and whether its accept branch is being explored
+	bool active = false;
+};
+
+// configuration of one search of the portfolio. the searches differ in the order in which the bounds
+// of a node are tried and in the order in which its children are explored
+struct Config {
+	std::string name;
+	bool bound1_first, ignore_first;
+};
+
+// counters of the search kept by each thread, and the state of its task in deterministic mode. a
+// block is aligned to two cache lines, which new allocates for an over-aligned type, so the counters
+// of two threads never share a line nor a pair of lines that the cpu prefetches together
+struct alignas(128) ThreadStats {
+	std::atomic<long int> nodes, pruned_bound1, pruned_bound2, tasks, leaves, incumbents;
+	double best;   // best hypervolume found by the task of the thread in deterministic mode
+	double shared; // best hypervolume of the earlier tasks of its epoch at its last sync point
+	long int task, task_nodes;
+};
+
+// each counter is written only by its own thread, so a plain store is enough and other threads
+// still read whole values
+inline void count(std::atomic<long int> &counter, long int value = 1){
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// counters of the nodes at one depth of the search tree, which is the number of points decided so
+// far. the times of the bounds are in nanoseconds, and the branches are those explored on the same
+// thread with the nodes of their subtrees
+struct DepthProfile {
+	long int nodes, leaves, incumbents;
+	long int bound1_evals, bound1_prunes, bound2_evals, bound2_prunes;
+	double bound1_time, bound2_time;
+	long int accepts, accept_nodes, ignores, ignore_nodes;
+};
+
+// kernels counted with '--counters' and the hardware events counted for them. the kernels nest, so
+// the hypervolumes computed by the bounds and by update are also counted in those kernels
+enum Kernel { KERNEL_HYPERVOLUME, KERNEL_UPDATE, KERNEL_BOUND1, KERNEL_BOUND2, KERNEL_HVC, KERNEL_WORK, KERNELS };
+enum Event { EVENT_CYCLES, EVENT_INSTRUCTIONS, EVENT_L1D_MISSES, EVENT_LLC_MISSES, EVENT_BRANCH_MISSES, EVENTS };
+
+// calls of a kernel on one thread with their nanoseconds and events
+struct KernelCounters {
+	long int calls;
+	double time, events[EVENTS];
+};
+
+// counters of the kernels of one thread and the events its cpu could count. without any event only
+// the time of the kernels is counted
+struct ThreadCounters {
+	KernelCounters kernels[KERNELS];
+	bool counted[EVENTS];
+};
+
+class Trace;
+struct Task;
+struct EpochShare;
+
+// asks a running search to stop. it may be cancelled from any thread or from a signal handler, and
+// the search then returns the best solution found so far
+struct CancelToken {
+	std::atomic<bool> requested {false};
+
+	void cancel(){ requested.store(true, std::memory_order_relaxed); }
+	bool cancelled() const { return requested.load(std::memory_order_relaxed); }
+};
+
+enum Affinity { AFFINITY_NONE, AFFINITY_COMPACT, AFFINITY_SCATTER };
+enum Split { SPLIT_IDLE, SPLIT_CUTOFF, SPLIT_ESTIMATE, SPLIT_HUNGER };
+
 struct Problem {
 	std::set<std::vector<int> > U;
 	std::mutex ping_mtx, subsets_mtx, solution_mtx;
 	Point *X, *solution;
-	double *ref, best, ping_time = 1.0;
-	std::vector<long int> nodes;
-	long int ntasks;
-	int n, k, dim, maximize, cores;
-	bool initialized, verbose, kset, pingmode, printpointsonly, devmode;
-	high_resolution_clock::time_point t0, ping;
+	double *ref, best, ping_time = 1.0, checkpoint_interval = 60.0, deadline;
+	ThreadStats *stats;
+	CancelToken *cancel;
+	Trace *trace; // timeline of the threads with '--trace'
+	EpochShare *epoch; // incumbents shared by the tasks of an epoch in deterministic mode
+	std::vector<Task> *frontier; // nodes at frontier_pos that the deterministic search collects as tasks
+	int frontier_pos;
+	std::vector<int> numa_nodes; // numa node of each pinned worker
+	std::vector<long int> task_sizes; // number of tasks by the log2 of the nodes they explored
+	std::vector<SearchPath> paths;
+	std::vector<std::vector<DepthProfile> > profiles; // profile of each thread by depth with '--profile'
+	std::vector<ThreadCounters> counters; // counters of the kernels of each thread with '--counters'
+	std::vector<double> contributions; // root exclusive contributions of the points, or with a warm start those it reuses and -1
+	std::vector<int> warm_subset, warm_added; // points in the subset of the previous solve and points added since, with a warm start
+	std::vector<std::vector<double> > warm_removed; // normalized points removed since the previous solve
+	std::string input_file, binary_file, checkpoint_file, resume_file, serve_address, worker_address, daemon_address, client_address, profile_file, trace_file, warm_file;
+	std::vector<std::string> input_files; // every input file given, solved one after another in batch mode
+	std::function<void(Problem *)> new_best; // called with the solution lock held
+	std::function<void(Problem *, const std::string &)> progress; // called with the type of each search_info
+	std::string error; // message of the last error
+	void *mapped; // binary input file whose coordinates are used in place
+	size_t mapped_size;
+	long int stop_after;
+	std::vector<Point> local_solution; // best subset seen by each thread in deterministic mode
+	std::vector<Config> portfolio; // searches raced by each thread in portfolio mode
+	int n, k, dim, maximize, cores, split_cutoff = 8, winner = -1;
+	Affinity affinity;
+	Split split;
+	bool initialized, verbose, kset, pingmode, printpointsonly, devmode, checkpointing, profiling, counting, deterministic, silent, batch, all_k;
+	std::atomic<bool> stopped;
+	high_resolution_clock::time_point t0, ping, checkpoint_time;
 };
 
 template <typename T> inline int gap(T *beg, T *end){ return end - beg; }
@@ -66,20 +170,45 @@ template <typename T> inline bool contains(std::vector<T> &A, T v){
 	return std::find(A.begin(), A.end(), v) != A.end();
 }
 
+inline bool cancelled(const Problem *P){ return P->cancel && P->cancel->cancelled(); }
+
+// normalizes a coordinate to the origin reference point and transforms it to a minimization problem.
+// fails when the reference point does not dominate the coordinate
+inline bool normalize(double value, double ref, double &coordinate, const Problem *P){
+	coordinate = (value - ref) * (!P->maximize - P->maximize);
+	return P->maximize ? ref < value : ref > value;
+}
+
+// initial position of a point of the problem. the coordinates of all points are kept in one block
+inline int point_index(const Point *p, const Problem *P){ return (p->values - P->X->values) / P->dim; }
+
+long int total(Problem * , std::atomic<long int> ThreadStats::* );
 void search_info(std::string , Problem *, int );
 void ping(Problem * , int );
 void concurrency_info(Problem * );
+void counter_info(Problem * );
+void profile_info(Problem * );
 Point *new_points(int , int , bool );
 bool eq__(double , double );
 bool stoi__(int * , std::string );
+bool stod__(double * , std::string );
 void assert__(std::string , bool ,  std::string , int , std::string );
 void flatten_set(Point * , double * , int , int , int );
 int initial_position(Point *, Problem * );
 bool is_comment(std::string );
+bool is_blank(std::string );
 void print_problem(Problem * );
 std::vector<int> solution_to_vector(Problem * );
 void clear_memory(Problem * );
+bool ERROR(Problem * , std::string = "" );
+bool check_options(Problem * );
 bool read_args(std::vector<std::string> , std::vector<double> & , std::ifstream & , Problem * );
+bool check_size(Problem * );
+bool load_points(const std::vector<double> & , std::vector<double> & , Problem * );
 bool read_input(std::ifstream & , std::vector<double> & , Problem * );
 
+extern const std::vector<Config> portfolio_configs;
+extern const char *kernel_names__[];
+extern const char *event_names__[];
+
 #endif
@@ -0,0 +1,329 @@
+#include "warm.h"
+
+const char warm_magic__[8] = {'H', 'S', 'S', 'P', 'W', 'R', 'M', '1'};
+
+// index of each point by its normalized coordinates, the first one of equal points
+std::map<std::vector<double>, int> point_indices(Problem *P){
+	std::map<std::vector<double>, int> indices;
+
+	for(int i = 0; i < P->n; ++i)
+		indices.emplace(std::vector<double>(P->X[i].values, P->X[i].values + P->dim), i);
+
+	return indices;
+}
+
+// reads the solve saved by '--warm'. its points are matched with the current ones by their normalized
+// coordinates, so the points that do not match were removed since and the current points that are not
+// matched were added. fails for a file of another dimension or reference point
+bool read_warm_start(const std::string &path, const std::vector<double> &ref, Problem *P){
+	char magic[sizeof(warm_magic__)];
+	int32_t n, dim, maximize;
+	std::ifstream file(path, std::ifstream::binary);
+
+	if(!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), warm_magic__))
+		return false;
+	if(!read__(file, n) || !read__(file, dim) || !read__(file, maximize) || n < 0)
+		return false;
+	if(dim != P->dim || maximize != P->maximize)
+		return false;
+
+	for(int d = 0; d < dim; ++d){
+		double value;
+		if(!read__(file, value) || value != ref[d])
+			return false;
+	}
+
+	const std::map<std::vector<double>, int> indices = point_indices(P);
+	std::vector<double> contributions(P->n, -1.0), x(dim);
+	std::vector<std::vector<double> > removed;
+	std::vector<int> subset, added;
+	std::vector<bool> matched(P->n, false);
+
+	for(int i = 0; i < n; ++i){
+		double contribution;
+		int32_t selected;
+
+		for(double &value : x)
+			if(!read__(file, value))
+				return false;
+		if(!read__(file, contribution) || !read__(file, selected))
+			return false;
+
+		const auto it = indices.find(x);
+		if(it == indices.end()){
+			removed.push_back(x);
+			continue;
+		}
+
+		matched[it->second] = true;
+		contributions[it->second] = contribution;
+		if(selected)
+			subset.push_back(it->second);
+	}
+
+	for(int i = 0; i < P->n; ++i)
+		if(!matched[i])
+			added.push_back(i);
+
+	P->warm_subset = subset;
+	P->warm_added = added;
+	P->warm_removed = removed;
+	P->contributions = contributions;
+	return true;
+}
+
+// writes the normalized points with their root exclusive contributions and whether they are in the
+// best subset. the previous file is replaced only when the new one is complete
+bool write_warm_start(const std::string &path, const std::vector<double> &ref, Problem *P){
+	if((int) P->contributions.size() != P->n)
+		return false;
+
+	std::vector<bool> selected(P->n, false);
+	for(Point *p = P->solution; P->best > -INF && p != P->solution + P->k; ++p)
+		selected[point_index(p, P)] = true;
+
+	const std::string tmp_file = path + ".tmp";
+	std::ofstream file(tmp_file, std::ofstream::binary | std::ofstream::trunc);
+
+	file.write(warm_magic__, sizeof(warm_magic__));
+	write__(file, (int32_t) P->n);
+	write__(file, (int32_t) P->dim);
+	write__(file, (int32_t) P->maximize);
+
+	for(int d = 0; d < P->dim; ++d)
+		write__(file, ref[d]);
+
+	for(int i = 0; i < P->n; ++i){
+		for(int d = 0; d < P->dim; ++d)
+			write__(file, P->X[i].values[d]);
+
+		write__(file, P->contributions[i]);
+		write__(file, (int32_t) selected[i]);
+	}
+
+	file.close();
+	return file.good() && !std::rename(tmp_file.c_str(), path.c_str());
+}
+
+// matches a warm start given in memory with the points of the problem. the coordinates are normalized
+// as the points are, and the points of the subset that are no longer in the archive are dropped
+bool init_warm_start(const WarmStart &warm, const std::vector<double> &ref, Problem *P){
+	const std::map<std::vector<double>, int> indices = point_indices(P);
+	std::vector<double> x(P->dim);
+
+	if(P->all_k)
+		return ERROR(P, "a warm start can not be used with every subset size\n");
+
+	auto normalized = [&](const std::vector<double> &point){
+		bool valid = (int) point.size() == P->dim;
+		for(int d = 0; valid && d < P->dim; ++d)
+			valid = normalize(point[d], ref[d], x[d], P);
+
+		return valid;
+	};
+
+	for(int i : warm.subset){
+		if(i < 0 || i >= P->n)
+			return ERROR(P, "invalid point " + std::to_string(i) + " of the warm start subset\n");
+
+		P->warm_subset.push_back(i);
+	}
+
+	for(const std::vector<double> &point : warm.subset_points){
+		if(!normalized(point))
+			return ERROR(P, "invalid point of the warm start subset\n");
+
+		const auto it = indices.find(x);
+		if(it != indices.end())
+			P->warm_subset.push_back(it->second);
+	}
+
+	if(warm.contributions.empty())
+		return true;
+	if((int) warm.contributions.size() != P->n)
+		return ERROR(P, "the warm start needs one contribution per point\n");
+
+	P->contributions = warm.contributions;
+
+	for(int i : warm.added){
+		if(i < 0 || i >= P->n)
+			return ERROR(P, "invalid added point " + std::to_string(i) + " of the warm start\n");
+
+		P->warm_added.push_back(i);
+		P->contributions[i] = -1.0;
+	}
+
+	for(const std::vector<double> &point : warm.removed){
+		if(!normalized(point))
+			return ERROR(P, "invalid removed point of the warm start\n");
+
+		P->warm_removed.push_back(x);
+	}
+
+	return true;
+}
+
+// a contribution of the previous solve is still exact when the region that a point added or removed
+// since dominates together with the point is also dominated by another point of both archives. that
+// is, when the corner of the region is dominated by that point. the other contributions are set to -1
+// and computed again. the contributions are all computed at once for d=3, so they are only reused for
+// the other dimensions
+void reuse_contributions(Problem *P){
+	if(P->contributions.empty() || P->dim == 3)
+		return;
+
+	std::vector<std::vector<double> > changes(P->warm_removed);
+	std::vector<bool> added(P->n, false);
+	std::vector<double> corner(P->dim);
+	int reused = 0;
+
+	for(int i : P->warm_added){
+		added[i] = true;
+		changes.emplace_back(P->X[i].values, P->X[i].values + P->dim);
+	}
+
+	for(int p = 0; p < P->n; ++p){
+		bool unaffected = !added[p] && P->contributions[p] >= 0.0;
+
+		for(int c = 0; unaffected && c < (int) changes.size(); ++c){
+			for(int d = 0; d < P->dim; ++d)
+				corner[d] = std::max(P->X[p].values[d], changes[c][d]);
+
+			bool covered = false;
+			for(int o = 0; !covered && o < P->n; ++o)
+				covered = o != p && !added[o] && std::equal(P->X[o].values, P->X[o].values + P->dim, corner.begin(), std::less_equal<double>());
+
+			unaffected = covered;
+		}
+
+		if(!unaffected)
+			P->contributions[p] = -1.0;
+
+		reused += unaffected;
+	}
+
+	if(P->verbose)
+		logger::info("warm start reused " + std::to_string(reused) + " of " + std::to_string(P->n) + " contributions");
+}
+
+// exclusive contributions of the points of a subset
+void subset_contributions(Point *T, int s, Point *aux1, double *out, Problem *P){
+	if(P->dim == 3 || P->dim == 4){
+		std::copy(T, T + s, aux1);
+		all_contributions(aux1, s, P->dim, P->ref, out);
+		return;
+	}
+
+	std::copy(T, T + s, aux1);
+	const double hv = hypervolume(aux1, s, P->dim, P->ref);
+
+	for(int i = 0; i < s; ++i){
+		std::copy(T, T + s, aux1);
+		std::iter_swap(aux1, aux1 + i);
+		out[i] = hv - hypervolume(aux1 + 1, s - 1, P->dim, P->ref);
+	}
+}
+
+// point outside of a subset with the largest contribution to it, or -1 when every point is in it
+int best_addition(Point *T, int s, double hv, const bool *in, Point *aux1, double &gain, Problem *P){
+	Point outside[P->n];
+	double C[P->n];
+	int m = 0;
+
+	for(int i = 0; i < P->n; ++i)
+		if(!in[i])
+			outside[m++] = P->X[i];
+
+	if(P->dim == 3)
+		get_contributions(outside, T, s, m, P->dim, P->ref, C);
+
+	for(int i = 0; P->dim != 3 && i < m; ++i)
+		C[i] = contribution(outside + i, T, aux1, s, hv, P);
+
+	if(m == 0)
+		return -1;
+
+	const int best = argmax(C, m);
+	gain = C[best];
+	return point_index(outside + best, P);
+}
+
+// repairs the subset of the previous solve into a subset of k points and improves it by local search,
+// which gives the search a strong first solution. the points beyond k with the least exclusive
+// contributions are dropped and the points with the largest contributions are added up to k. then a
+// point of the subset, tried from the least exclusive contribution, is swapped with the best point
+// outside while that grows the hypervolume
+void warm_incumbent(Problem *P){
+	if(P->warm_subset.empty() || P->k <= 1 || P->k >= P->n - 1)
+		return;
+
+	Point T[P->n], aux1[P->n];
+	double Ce[P->n];
+	bool in[P->n];
+	int s = 0, order[P->n];
+
+	std::fill(in, in + P->n, false);
+	for(int i : P->warm_subset){
+		if(!in[i])
+			T[s++] = P->X[i];
+
+		in[i] = true;
+	}
+
+	std::copy(T, T + s, aux1);
+	double hv = hypervolume(aux1, s, P->dim, P->ref), gain = 0.0;
+
+	while(s > P->k){
+		subset_contributions(T, s, aux1, Ce, P);
+		const int minp = argmin(Ce, s);
+
+		in[point_index(T + minp, P)] = false;
+		hv -= Ce[minp];
+		T[minp] = T[--s];
+	}
+
+	while(s < P->k){
+		const int q = best_addition(T, s, hv, in, aux1, gain, P);
+
+		in[q] = true;
+		hv += gain;
+		T[s++] = P->X[q];
+	}
+
+	for(int swaps = 0; swaps < P->n; ++swaps){
+		bool improved = false;
+
+		subset_contributions(T, s, aux1, Ce, P);
+		std::iota(order, order + s, 0);
+		std::sort(order, order + s, [&](int a, int b){ return Ce[a] < Ce[b]; });
+
+		for(int a = 0; !improved && a < s; ++a){
+			// the point tried is moved out of the subset to its last position
+			std::iter_swap(T + order[a], T + s - 1);
+			const double rest = hv - Ce[order[a]];
+			const int q = best_addition(T, s - 1, rest, in, aux1, gain, P);
+
+			improved = q >= 0 && rest + gain > hv && !eq__(rest + gain, hv);
+			if(improved){
+				in[point_index(T + s - 1, P)] = false;
+				in[q] = true;
+				T[s - 1] = P->X[q];
+				hv = rest + gain;
+			}
+			else
+				std::iter_swap(T + order[a], T + s - 1);
+		}
+
+		if(!improved)
+			break;
+	}
+
+	std::copy(T, T + s, aux1);
+	hv = hypervolume(aux1, s, P->dim, P->ref);
+
+	if(hv > P->best){
+		P->best = hv;
+		std::copy(T, T + s, P->solution);
+		search_info("init", P, 0);
+	}
+}
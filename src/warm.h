@@ -0,0 +1,26 @@
+#ifndef WARM_H
+#define WARM_H
+
+#include "util.h"
+#include "hssp.h"
+#include "solver.h"
+#include "checkpoint.h"
+
+#include <string>    // string
+#include <vector>    // vector
+#include <map>       // map
+#include <fstream>   // ifstream, ofstream
+#include <algorithm> // copy, fill, sort, equal, max, iter_swap
+#include <numeric>   // iota
+#include <functional> // less_equal
+#include <cstdio>    // rename
+#include <cstdint>   // int32_t
+
+std::map<std::vector<double> , int> point_indices(Problem * );
+bool read_warm_start(const std::string & , const std::vector<double> & , Problem * );
+bool write_warm_start(const std::string & , const std::vector<double> & , Problem * );
+bool init_warm_start(const WarmStart & , const std::vector<double> & , Problem * );
+void reuse_contributions(Problem * );
+void warm_incumbent(Problem * );
+
+#endif